@@ -0,0 +1,111 @@
+/**
+ * @file area.h
+ * @brief Header file for the summed-area table over the map.
+ *
+ * @details
+ * An AreaTable holds, for every cell (r, c), the sum of the values of the
+ * cells above and to the left of it. The sum over any rectangle then takes
+ * four lookups, whatever its size. The values come from a danger bitset
+ * (one per dangerous cell) or from a heatmap (the pair count of each cell).
+ *
+ * @author Ahmet Abdullah GULTEKIN
+ * @date 2025-05-25
+ */
+
+#ifndef PRACTICALWORK_AREA_H
+#define PRACTICALWORK_AREA_H
+
+#pragma once //the same
+
+#include <stddef.h> /* size_t */
+#include <stdint.h> /* uint64_t, int32_t */
+#include "../include/graph.h"
+#include "../include/bitgrid.h"
+#include "../include/danger.h"
+
+/**
+ * Rows and columns per task when an AreaTable is loaded, and queries per task in a batch.
+ */
+#define AREA_ROW_BLOCK 64
+#define AREA_COL_BLOCK 1024
+#define AREA_QUERY_CHUNK 4096
+
+/**
+ * @struct AreaTable
+ *
+ * @brief AreaTable structure holding the summed-area table of a rows x cols map.
+ * sum[r * (cols + 1) + c] is the total of the cells [0, r) x [0, c).
+ */
+typedef struct {
+    int32_t rows;        /* map height                          */
+    int32_t cols;        /* map width                           */
+    uint64_t *sum;       /* (rows + 1) x (cols + 1) prefix sums */
+} AreaTable;
+
+/**
+ * @brief Initialize an all-zero table for a map.
+ * @param t Pointer to the table to be initialized.
+ * @param rows Map height.
+ * @param cols Map width.
+ *
+ * @return Status code indicating success or failure.
+ */
+Status area_table_init(AreaTable *t, int32_t rows, int32_t cols);
+
+/**
+ * @brief Load the cells of a bitset, counting one per set cell, from a given row down.
+ * @details Only the rows from from_row on are read again; the sums above it are
+ * kept, so after a change confined to the rows at or below from_row the table is
+ * brought up to date in O((rows - from_row) * cols). Row prefixes are computed in
+ * parallel over blocks of AREA_ROW_BLOCK rows, then the column sums in parallel
+ * over blocks of AREA_COL_BLOCK columns. Pass 0 to build the whole table.
+ * @param t Pointer to the table.
+ * @param b Bitset of the cells; cells outside its window count as zero.
+ * @param from_row First row to reload.
+ * @param n_workers Number of worker threads (0 for one per processor).
+ *
+ * @return Status code indicating success or failure.
+ */
+Status area_table_load_bits(AreaTable *t, const BitGrid *b, int32_t from_row, size_t n_workers);
+
+/**
+ * @brief Load the pair counts of a heatmap, from a given row down.
+ * @details Same as area_table_load_bits(), with each cell counting its heatmap value.
+ * @param t Pointer to the table.
+ * @param h Heatmap of the same size as the table.
+ * @param from_row First row to reload.
+ * @param n_workers Number of worker threads (0 for one per processor).
+ *
+ * @return Status code indicating success or failure.
+ */
+Status area_table_load_heatmap(AreaTable *t, const Heatmap *h, int32_t from_row, size_t n_workers);
+
+/**
+ * @brief Sum the cells of a rectangle in O(1).
+ * @param t Pointer to the table.
+ * @param r Rectangle; the part outside the map is ignored.
+ *
+ * @return The sum over the rectangle.
+ */
+uint64_t area_table_count(const AreaTable *t, const Region *r);
+
+/**
+ * @brief Sum the cells of many rectangles.
+ * @details Rectangles are answered in chunks of AREA_QUERY_CHUNK on the thread pool.
+ * @param t Pointer to the table.
+ * @param r Rectangles.
+ * @param n Number of rectangles.
+ * @param n_workers Number of worker threads (0 for one per processor).
+ * @param out Output array of n sums.
+ *
+ * @return Status code indicating success or failure.
+ */
+Status area_table_count_batch(const AreaTable *t, const Region *r, size_t n, size_t n_workers, uint64_t *out);
+
+/**
+ * @brief Free the resources of an AreaTable.
+ * @param t Pointer to the table to be freed.
+ */
+void area_table_free(AreaTable *t);
+
+#endif //PRACTICALWORK_AREA_H
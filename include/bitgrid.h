@@ -0,0 +1,198 @@
+/**
+ * @file bitgrid.h
+ * @brief Header file for the bitset over a rectangular window of grid cells.
+ *
+ * @details
+ * A BitGrid stores one bit per cell of a rows x cols window whose top-left
+ * cell is (row0, col0). Cells are laid out row-major in 64-bit words, so
+ * set operations between grids with the same window run word by word.
+ *
+ * @author Ahmet Abdullah GULTEKIN
+ * @date 2025-05-25
+ */
+
+#ifndef PRACTICALWORK_BITGRID_H
+#define PRACTICALWORK_BITGRID_H
+
+#pragma once //the same
+
+#include <stddef.h> /* size_t */
+#include <stdint.h> /* uint64_t, int32_t */
+#include <stdbool.h>
+#if defined(_MSC_VER)
+#include <intrin.h>     /* __popcnt64, _BitScanForward64 */
+#endif
+#include "../include/graph.h"
+
+/**
+ * @struct BitGrid
+ *
+ * @brief BitGrid structure representing a set of cells inside a window.
+ */
+typedef struct {
+    int32_t row0;        /* row of the top-left cell            */
+    int32_t col0;        /* column of the top-left cell         */
+    int32_t rows;        /* window height                       */
+    int32_t cols;        /* window width                        */
+    size_t words;        /* number of 64-bit words              */
+    uint64_t *bits;      /* row-major cell bits                 */
+} BitGrid;
+
+/**
+ * @brief Count the set bits of a word.
+ * @param w Word to count.
+ *
+ * @return The number of set bits.
+ */
+static inline size_t bitgrid_popcount(uint64_t w) {
+#if defined(_MSC_VER)
+    return (size_t) __popcnt64(w);
+#elif defined(__GNUC__)
+    return (size_t) __builtin_popcountll(w);
+#else
+    size_t c = 0;
+    for (; w; w &= w - 1) c++;
+    return c;
+#endif
+}
+
+/**
+ * @brief Get the index of the lowest set bit of a non-zero word.
+ * @param w Non-zero word.
+ *
+ * @return The bit index.
+ */
+static inline unsigned bitgrid_lowest_bit(uint64_t w) {
+#if defined(_MSC_VER)
+    unsigned long i;
+    _BitScanForward64(&i, w);
+    return (unsigned) i;
+#elif defined(__GNUC__)
+    return (unsigned) __builtin_ctzll(w);
+#else
+    unsigned i = 0;
+    while (!(w & 1)) {
+        w >>= 1;
+        i++;
+    }
+    return i;
+#endif
+}
+
+/**
+ * @brief Initialize an empty grid over a window.
+ * @param b Pointer to the grid to be initialized.
+ * @param row0 Row of the top-left cell.
+ * @param col0 Column of the top-left cell.
+ * @param rows Window height.
+ * @param cols Window width.
+ *
+ * @return Status code indicating success or failure.
+ */
+Status bitgrid_init(BitGrid *b, int32_t row0, int32_t col0, int32_t rows, int32_t cols);
+
+/**
+ * @brief Free the resources of a grid.
+ * @param b Pointer to the grid to be freed.
+ */
+void bitgrid_free(BitGrid *b);
+
+/**
+ * @brief Clear every cell of a grid.
+ * @param b Pointer to the grid.
+ */
+void bitgrid_clear(BitGrid *b);
+
+/**
+ * @brief Check whether a cell lies inside the window of the grid.
+ * @param b Pointer to the grid.
+ * @param row Row of the cell.
+ * @param col Column of the cell.
+ *
+ * @return True if the cell is inside the window, false otherwise.
+ */
+static inline bool bitgrid_in_window(const BitGrid *b, int64_t row, int64_t col) {
+    return row >= b->row0 && row < (int64_t) b->row0 + b->rows &&
+           col >= b->col0 && col < (int64_t) b->col0 + b->cols;
+}
+
+/**
+ * @brief Get the bit index of a cell that lies inside the window.
+ * @param b Pointer to the grid.
+ * @param row Row of the cell.
+ * @param col Column of the cell.
+ *
+ * @return The row-major bit index.
+ */
+static inline size_t bitgrid_index(const BitGrid *b, int64_t row, int64_t col) {
+    return (size_t) (row - b->row0) * (size_t) b->cols + (size_t) (col - b->col0);
+}
+
+/**
+ * @brief Set a cell; cells outside the window are ignored.
+ * @param b Pointer to the grid.
+ * @param row Row of the cell.
+ * @param col Column of the cell.
+ *
+ * @return True if the cell was inside the window and not set before.
+ */
+static inline bool bitgrid_set(BitGrid *b, int64_t row, int64_t col) {
+    if (!bitgrid_in_window(b, row, col)) return false;
+    size_t i = bitgrid_index(b, row, col);
+    uint64_t mask = (uint64_t) 1 << (i & 63);
+    bool was = (b->bits[i >> 6] & mask) != 0;
+    b->bits[i >> 6] |= mask;
+    return !was;
+}
+
+/**
+ * @brief Test a cell; cells outside the window are reported as unset.
+ * @param b Pointer to the grid.
+ * @param row Row of the cell.
+ * @param col Column of the cell.
+ *
+ * @return True if the cell is set, false otherwise.
+ */
+static inline bool bitgrid_test(const BitGrid *b, int64_t row, int64_t col) {
+    if (!bitgrid_in_window(b, row, col)) return false;
+    size_t i = bitgrid_index(b, row, col);
+    return (b->bits[i >> 6] >> (i & 63)) & 1;
+}
+
+/**
+ * @brief Merge src into dst (dst |= src); both grids must share the same window.
+ * @param dst Pointer to the destination grid.
+ * @param src Pointer to the source grid.
+ *
+ * @return Status code indicating success or failure.
+ */
+Status bitgrid_or(BitGrid *dst, const BitGrid *src);
+
+/**
+ * @brief Intersect src into dst (dst &= src); both grids must share the same window.
+ * @details Uses 256-bit AVX2 operations when the compiler targets them.
+ * @param dst Pointer to the destination grid.
+ * @param src Pointer to the source grid.
+ *
+ * @return Status code indicating success or failure.
+ */
+Status bitgrid_and(BitGrid *dst, const BitGrid *src);
+
+/**
+ * @brief Count the set cells of a grid.
+ * @param b Pointer to the grid.
+ *
+ * @return The number of set cells.
+ */
+size_t bitgrid_count(const BitGrid *b);
+
+/**
+ * @brief Append the set cells of a grid to a list, in row-major order.
+ * @param b Pointer to the grid.
+ * @param out Pointer to the list; it must be initialized.
+ *
+ * @return Status code indicating success or failure.
+ */
+Status bitgrid_to_list(const BitGrid *b, CoordList *out);
+
+#endif //PRACTICALWORK_BITGRID_H
@@ -0,0 +1,108 @@
+/**
+ * @file coord_set.h
+ * @brief Header file for the open-addressing hash set of grid coordinates.
+ *
+ * @details
+ * The set is used to deduplicate coordinates (e.g. danger points) in
+ * expected O(1) per operation, instead of scanning an array for every
+ * insertion.
+ *
+ * @author Ahmet Abdullah GULTEKIN
+ * @date 2025-05-25
+ */
+
+#ifndef PRACTICALWORK_COORD_SET_H
+#define PRACTICALWORK_COORD_SET_H
+
+#pragma once //the same
+
+#include <stddef.h> /* size_t */
+#include <stdint.h> /* uint64_t */
+#include <stdbool.h>
+#include "../include/graph.h"
+
+/**
+ * @struct CoordSet
+ *
+ * @brief CoordSet structure representing a hash set of coordinates.
+ * Keys are the (row, col) pair packed into 64 bits and probed linearly.
+ * Each key also records how many times it was inserted.
+ */
+typedef struct {
+    uint64_t *keys;      /* packed (row, col) keys               */
+    uint32_t *hits;      /* insertions of each key               */
+    uint8_t *used;       /* slot occupancy flags                 */
+    size_t cap;          /* slot count (power of two)            */
+    size_t count;        /* number of stored coordinates         */
+} CoordSet;
+
+/**
+ * @brief Get the coordinate stored in a slot of the set.
+ * @param s Pointer to the set.
+ * @param slot Slot index; the slot must be in use.
+ *
+ * @return The coordinate.
+ */
+static inline Coord coord_set_at(const CoordSet *s, size_t slot) {
+    return (Coord) {.row = (int32_t) (uint32_t) (s->keys[slot] >> 32), .col = (int32_t) (uint32_t) s->keys[slot]};
+}
+
+/**
+ * @brief Initialize a coordinate set sized for an expected number of keys.
+ * @param s Pointer to the set to be initialized.
+ * @param expected Expected number of distinct coordinates.
+ *
+ * @return Status code indicating success or failure.
+ */
+Status coord_set_init(CoordSet *s, size_t expected);
+
+/**
+ * @brief Free the resources of a coordinate set.
+ * @param s Pointer to the set to be freed.
+ */
+void coord_set_free(CoordSet *s);
+
+/**
+ * @brief Insert a coordinate into the set, growing it if needed.
+ * @details Inserting a coordinate that is already present only increments its
+ * insertion count.
+ * @param s Pointer to the set.
+ * @param c Coordinate to insert.
+ * @param inserted Optional output, true if the coordinate was not present before.
+ *
+ * @return Status code indicating success or failure.
+ */
+Status coord_set_insert(CoordSet *s, Coord c, bool *inserted);
+
+/**
+ * @brief Undo one insertion of a coordinate, removing it once its count reaches zero.
+ * @details Removal shifts the following keys of the probe run back, so lookups
+ * stay correct without tombstones.
+ * @param s Pointer to the set.
+ * @param c Coordinate to release.
+ * @param removed Optional output, true if the coordinate left the set.
+ *
+ * @return Status code indicating success or failure
+ * (STATUS_NOT_FOUND if the coordinate is not in the set).
+ */
+Status coord_set_release(CoordSet *s, Coord c, bool *removed);
+
+/**
+ * @brief Check whether a coordinate is in the set.
+ * @param s Pointer to the set.
+ * @param c Coordinate to look up.
+ *
+ * @return True if the coordinate is in the set, false otherwise.
+ */
+bool coord_set_contains(const CoordSet *s, Coord c);
+
+/**
+ * @brief Get the number of times a coordinate was inserted.
+ * @param s Pointer to the set.
+ * @param c Coordinate to look up.
+ *
+ * @return The insertion count, 0 if the coordinate is not in the set.
+ */
+uint32_t coord_set_hits(const CoordSet *s, Coord c);
+
+#endif //PRACTICALWORK_COORD_SET_H
@@ -0,0 +1,350 @@
+/**
+ * @file danger.h
+ * @brief Header file for the bulk danger analysis over all frequencies.
+ *
+ * @details
+ * Where graph_danger_points() answers for a single frequency, the functions
+ * in this file analyse every frequency of the graph at once. Vertices are
+ * bucketed by frequency a single time and the buckets are processed in
+ * parallel, writing into BitGrid sets instead of coordinate lists.
+ *
+ * @author Ahmet Abdullah GULTEKIN
+ * @date 2025-05-25
+ */
+
+#ifndef PRACTICALWORK_DANGER_H
+#define PRACTICALWORK_DANGER_H
+
+#pragma once //the same
+
+#include <stddef.h> /* size_t */
+#include <stdint.h> /* uint64_t */
+#include "../include/graph.h"
+#include "../include/bitgrid.h"
+#include "../include/coord_set.h"
+
+/**
+ * @struct DangerMap
+ *
+ * @brief DangerMap structure holding the in-map danger cells of every frequency.
+ * All grids share the same window, so they can be combined word by word.
+ */
+typedef struct {
+    BitGrid all;         /* union of the danger cells of all frequencies */
+    size_t count;        /* number of frequencies present in the graph   */
+    char *freq;          /* frequency of each per-frequency grid         */
+    BitGrid *grid;       /* danger cells of each frequency               */
+} DangerMap;
+
+/**
+ * @struct Heatmap
+ *
+ * @brief Heatmap structure counting, for every map cell, the same-frequency
+ * pairs that put an antinode on it (all frequencies together).
+ */
+typedef struct {
+    int32_t rows;        /* map height                          */
+    int32_t cols;        /* map width                           */
+    uint32_t *count;     /* row-major pair count of each cell   */
+} Heatmap;
+
+/**
+ * @brief Compute the danger cells of every frequency in parallel.
+ * @details The vertices are bucketed by frequency once, then each frequency is
+ * a task on the thread pool. Every worker also accumulates its frequencies in a
+ * private union grid; the private grids are merged into DangerMap::all at the end.
+ * @param g Pointer to the graph.
+ * @param n_workers Number of worker threads (0 for one per processor).
+ * @param out Pointer to the DangerMap to be filled.
+ *
+ * @return Status code indicating success or failure.
+ */
+Status graph_danger_all(const Graph *g, size_t n_workers, DangerMap *out);
+
+/**
+ * Bucket size from which graph_danger_harmonics() spreads the pairs over the thread pool.
+ */
+#define HARMONICS_PARALLEL_MIN 64
+
+/**
+ * @brief Compute the resonant-harmonics danger cells of one frequency.
+ * @details In this model every cell on the line through a same-frequency pair,
+ * at an integer multiple of the reduced step (dr/gcd, dc/gcd), is dangerous.
+ * Each line is walked to the map boundary only, so the work of a pair is
+ * proportional to the cells it visits. Buckets of at least
+ * HARMONICS_PARALLEL_MIN antennas are split over the thread pool with one
+ * private grid per worker.
+ * @param g Pointer to the graph.
+ * @param freq Frequency to check.
+ * @param n_workers Number of worker threads (0 for one per processor).
+ * @param out Pointer to the BitGrid to be initialized and filled (window = map).
+ *
+ * @return Status code indicating success or failure.
+ */
+Status graph_danger_harmonics(const Graph *g, char freq, size_t n_workers, BitGrid *out);
+
+/**
+ * @brief Find the cells that are dangerous for at least m of the given frequencies.
+ * @details The danger grids of the requested frequencies are computed in
+ * parallel and combined word by word: with m equal to the number of distinct
+ * frequencies the grids are ANDed (with AVX2 when available), otherwise a
+ * bit-sliced counter adds the 64 cells of a word at once. graph_danger_overlaps()
+ * is the special case of two frequencies and m = 2.
+ * @param g Pointer to the graph.
+ * @param freqs Array of frequencies (duplicates are counted once).
+ * @param k Number of entries in freqs.
+ * @param m Minimum number of frequencies a cell must be dangerous for (at least 1).
+ * @param n_workers Number of worker threads (0 for one per processor).
+ * @param out Pointer to the CoordList to store the cells, in row-major order.
+ * @param counts Optional output: if not NULL, receives an allocated array with, for
+ * every cell of out, the number of frequencies it is dangerous for. Free it with free().
+ *
+ * @return Status code indicating success or failure.
+ */
+Status graph_danger_overlaps_multi(const Graph *g, const char *freqs, size_t k, size_t m,
+                                   size_t n_workers, CoordList *out, uint32_t **counts);
+
+/**
+ * @brief Count, for every map cell, the same-frequency pairs that put an antinode on it.
+ * @details The anchors of all frequency buckets are spread over the thread pool;
+ * each worker increments a private counter grid and the grids are summed in a
+ * parallel reduction over row blocks. Only in-map antinodes are counted.
+ * @param g Pointer to the graph.
+ * @param n_workers Number of worker threads (0 for one per processor).
+ * @param out Pointer to the Heatmap to be filled.
+ *
+ * @return Status code indicating success or failure.
+ */
+Status graph_danger_heatmap(const Graph *g, size_t n_workers, Heatmap *out);
+
+/**
+ * @brief Save a heatmap as a plain (P2) PGM image, brighter cells receiving more interference.
+ * @param h Pointer to the heatmap.
+ * @param path Path to the output file.
+ *
+ * @return Status code indicating success or failure.
+ */
+Status heatmap_save_pgm(const Heatmap *h, const char *path);
+
+/**
+ * @brief Save the non-zero cells of a heatmap as CSV lines "row,col,count".
+ * @param h Pointer to the heatmap.
+ * @param path Path to the output file.
+ *
+ * @return Status code indicating success or failure.
+ */
+Status heatmap_save_csv(const Heatmap *h, const char *path);
+
+/**
+ * @brief Free the resources of a Heatmap.
+ * @param h Pointer to the heatmap to be freed.
+ */
+void heatmap_free(Heatmap *h);
+
+/**
+ * @brief Get the danger grid of one frequency.
+ * @param m Pointer to the map.
+ * @param freq Frequency to look up.
+ *
+ * @return Pointer to the grid, or NULL if the frequency is not in the graph.
+ */
+const BitGrid *danger_map_find(const DangerMap *m, char freq);
+
+/**
+ * @brief Free the resources of a DangerMap.
+ * @param m Pointer to the map to be freed.
+ */
+void danger_map_free(DangerMap *m);
+
+/**
+ * @struct FreqMask
+ *
+ * @brief FreqMask structure holding a set of frequencies, one bit per frequency.
+ */
+typedef struct {
+    uint64_t bits[FREQ_SLOTS / 64];
+} FreqMask;
+
+/**
+ * @brief Add a frequency to a mask.
+ * @param m Pointer to the mask.
+ * @param freq Frequency to add.
+ */
+static inline void freq_mask_add(FreqMask *m, char freq) {
+    m->bits[(unsigned char) freq >> 6] |= (uint64_t) 1 << ((unsigned char) freq & 63);
+}
+
+/**
+ * @brief Remove a frequency from a mask.
+ * @param m Pointer to the mask.
+ * @param freq Frequency to remove.
+ */
+static inline void freq_mask_remove(FreqMask *m, char freq) {
+    m->bits[(unsigned char) freq >> 6] &= ~((uint64_t) 1 << ((unsigned char) freq & 63));
+}
+
+/**
+ * @brief Check whether a mask holds a frequency.
+ * @param m Pointer to the mask.
+ * @param freq Frequency to look up.
+ *
+ * @return True if the frequency is in the mask, false otherwise.
+ */
+static inline bool freq_mask_has(const FreqMask *m, char freq) {
+    return (m->bits[(unsigned char) freq >> 6] >> ((unsigned char) freq & 63)) & 1;
+}
+
+/**
+ * @struct DangerIndex
+ *
+ * @brief DangerIndex structure holding the in-map danger cells of the graph for point queries.
+ * The hit count of a cell is the number of same-frequency pairs that put an
+ * antinode on it in its frequency set, and the number of frequencies it is
+ * dangerous for in the combined set. These reference counts let an edit add or
+ * withdraw the antinodes of its own pairs without recomputing the others.
+ */
+typedef struct DangerIndex {
+    CoordSet all;                 /* cells dangerous for any frequency   */
+    CoordSet freq[FREQ_SLOTS];    /* danger cells of each frequency      */
+    FreqMask present;             /* frequencies with a danger cell      */
+} DangerIndex;
+
+/**
+ * Queries answered by one task of graph_is_dangerous_batch().
+ */
+#define DANGER_QUERY_CHUNK 4096
+
+/**
+ * @brief Check whether a cell is dangerous for any of the given frequencies.
+ * @details The first query builds a DangerIndex held on the graph, in
+ * parallel over the frequencies. From then on graph_insert_vertex(),
+ * graph_remove_vertex() and graph_retune_vertex() keep it current (see
+ * danger_index_add_antenna()); other
+ * changes get it rebuilt on the next query. A query costs one hash lookup in the
+ * combined set, plus one per requested frequency when the cell is dangerous at all.
+ * @param g Pointer to the graph.
+ * @param row Row of the cell.
+ * @param col Column of the cell.
+ * @param mask Frequencies to check, NULL for all of them.
+ * @param dangerous Pointer to store the result.
+ *
+ * @return Status code indicating success or failure.
+ */
+Status graph_is_dangerous(Graph *g, int32_t row, int32_t col, const FreqMask *mask, bool *dangerous);
+
+/**
+ * @brief Check many cells at once for danger from any of the given frequencies.
+ * @details Same answers as graph_is_dangerous(). The index is brought up to date
+ * once, then the cells are checked in chunks of DANGER_QUERY_CHUNK on the thread pool.
+ * @param g Pointer to the graph.
+ * @param cells Cells to check.
+ * @param n Number of cells.
+ * @param mask Frequencies to check, NULL for all of them.
+ * @param n_workers Number of worker threads (0 for one per processor).
+ * @param dangerous Output array of n results.
+ *
+ * @return Status code indicating success or failure.
+ */
+Status graph_is_dangerous_batch(Graph *g, const Coord *cells, size_t n, const FreqMask *mask,
+                                size_t n_workers, bool *dangerous);
+
+/**
+ * @brief Get the danger index of the graph, building it if it is missing or stale.
+ * @param g Pointer to the graph.
+ * @param out Pointer to store the index; it stays valid until the graph is freed
+ * and is kept current by graph_insert_vertex(), graph_remove_vertex() and
+ * graph_retune_vertex().
+ *
+ * @return Status code indicating success or failure.
+ */
+Status graph_danger_index(Graph *g, const DangerIndex **out);
+
+/**
+ * @brief Add the antinodes that a newly inserted antenna forms with the other antennas of its frequency.
+ * @details O(k) for a frequency of k antennas: the adjacency list of the antenna (its
+ * frequency clique) is walked and only the new pairs are counted.
+ * Called by graph_insert_vertex() while the index is current; an insert that
+ * enlarges the map marks the index stale instead, because old pairs can then
+ * gain in-map antinodes.
+ * @param ix Pointer to the index.
+ * @param g Pointer to the graph, already holding the antenna.
+ * @param idx Vertex index of the antenna.
+ *
+ * @return Status code indicating success or failure.
+ */
+Status danger_index_add_antenna(DangerIndex *ix, const Graph *g, size_t idx);
+
+/**
+ * @brief Withdraw the antinodes of an antenna that is about to be removed.
+ * @details O(k): the counts of the antenna's pairs are decremented, and cells
+ * whose count drops to zero leave the index.
+ * @param ix Pointer to the index.
+ * @param g Pointer to the graph, still holding the antenna.
+ * @param idx Vertex index of the antenna.
+ *
+ * @return Status code indicating success or failure.
+ */
+Status danger_index_remove_antenna(DangerIndex *ix, const Graph *g, size_t idx);
+
+/**
+ * @brief Free the resources of a DangerIndex.
+ * @param ix Pointer to the index to be freed.
+ */
+void danger_index_free(DangerIndex *ix);
+
+/**
+ * @struct HotCell
+ *
+ * @brief HotCell structure holding a map cell and the number of same-frequency pairs hitting it.
+ */
+typedef struct {
+    Coord cell;          /* map cell                            */
+    uint32_t count;      /* pairs putting an antinode on it     */
+} HotCell;
+
+/**
+ * @brief Find the k cells of a heatmap hit by the most pairs.
+ * @details Row blocks are tasks on the thread pool; every worker keeps its best
+ * k cells in a bounded min-heap, so a cell that cannot make the cut costs one
+ * comparison. Only the n_workers * k survivors are sorted, never the whole map.
+ * Cells of equal count are ranked in row-major order; cells without pairs are
+ * never reported.
+ * @param h Pointer to the heatmap.
+ * @param k Number of cells wanted.
+ * @param n_workers Number of worker threads (0 for one per processor).
+ * @param out Output array of at least k cells, the most interfered first.
+ * @param count Pointer to store the number of cells written (at most k).
+ *
+ * @return Status code indicating success or failure.
+ */
+Status heatmap_top_cells(const Heatmap *h, size_t k, size_t n_workers, HotCell *out, size_t *count);
+
+/**
+ * @struct AntennaImpact
+ *
+ * @brief AntennaImpact structure holding the danger attributed to one antenna.
+ */
+typedef struct {
+    size_t idx;          /* vertex index of the antenna                     */
+    size_t cleared;      /* danger cells that removing it would make safe   */
+    size_t touched;      /* danger cells its own pairs put an antinode on   */
+} AntennaImpact;
+
+/**
+ * @brief Find the k antennas whose removal would clear the most danger cells.
+ * @details Each antenna counts the antinodes of its own pairs per cell, and a cell
+ * is cleared when those pairs are all the pairs of its frequency on it (the hit
+ * count of the DangerIndex) and no other frequency is dangerous there. Antennas
+ * are spread over the thread pool in chunks, each worker keeping its best k in a
+ * bounded heap. Ties are broken by touched cells, then by vertex index.
+ * @param g Pointer to the graph; its danger index is built if needed.
+ * @param k Number of antennas wanted.
+ * @param n_workers Number of worker threads (0 for one per processor).
+ * @param out Output array of at least k entries, the most harmful antenna first.
+ * @param count Pointer to store the number of entries written (at most k).
+ *
+ * @return Status code indicating success or failure.
+ */
+Status graph_top_antennas(Graph *g, size_t k, size_t n_workers, AntennaImpact *out, size_t *count);
+
+#endif //PRACTICALWORK_DANGER_H
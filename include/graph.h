@@ -27,9 +27,11 @@
 
 #pragma once //the same
 
+#include <stdio.h>  /* FILE */
 #include <stddef.h> /* size_t */
 #include <stdint.h> /* int32_t */
 #include <stdbool.h>
+#include <time.h>   /* timespec_get */
 
 /**
  * @struct Status
@@ -53,7 +55,8 @@ typedef enum {
     STATUS_EMPTY,      /* empty data structure                */
     STATUS_OVERFLOW,   /* overflow error                     */
     STATUS_UNDERFLOW,  /* underflow error                    */
-    STATUS_UNSUPPORTED /* unsupported operation              */
+    STATUS_UNSUPPORTED, /* unsupported operation             */
+    STATUS_STOP        /* a callback asked to stop early      */
 } Status;
 
 /**
@@ -88,13 +91,24 @@ typedef struct {
  * @brief Graph structure representing a graph.
  * It contains an array of vertices,
  * an array of adjacency lists,
- * and the current vertex count.
+ * the current vertex count,
+ * the size of the map the antennas are placed on,
+ * a union-find over the vertices that tracks the connected components
+ * and the danger index answering point queries (built on first use).
  */
 struct Graph {
     Vertex *v;           /* dynamic array of vertices           */
     EdgeNode **adj;      /* array of adjacency lists            */
     size_t n;            /* current vertex count                */
     size_t cap;          /* allocated capacity                  */
+    int32_t rows;        /* map height (grows to fit inserts)   */
+    int32_t cols;        /* map width (grows to fit inserts)    */
+    size_t *uf_parent;   /* union-find parent of each vertex    */
+    size_t *uf_size;     /* vertex count of each root's set     */
+    uint8_t *uf_rank;    /* union-by-rank bound of each root    */
+    bool uf_stale;       /* a removal invalidated the sets      */
+    struct DangerIndex *danger; /* danger cells, NULL until queried */
+    bool danger_stale;   /* an edit invalidated the index       */
 };
 
 /**
@@ -130,8 +144,45 @@ typedef struct {
 typedef struct {
     Path *path;       /* dynamic array */
     size_t count;
+    size_t cap;       /* allocated paths */
 } PathSet;
 
+/**
+ * Function pointer type for receiving paths during all-paths enumeration.
+ * The path buffer is reused and only valid during the call; returning
+ * STATUS_STOP ends the enumeration early, any other non-OK code aborts it.
+ */
+typedef Status (*PathFn)(const size_t *path, size_t len, void *ctx);
+
+/**
+ * @struct PathLimits
+ *
+ * @brief PathLimits structure bounding an all-paths enumeration.
+ * A zero field means no limit.
+ */
+typedef struct {
+    size_t max_paths;    /* stop after this many paths           */
+    size_t max_depth;    /* longest path, in edges               */
+    uint32_t max_ms;     /* wall-clock budget in milliseconds    */
+} PathLimits;
+
+/**
+ * Path enumerations check the wall clock, and the parallel one its stop
+ * requests, once every this many DFS steps.
+ */
+#define PATH_CLOCK_STRIDE 1024
+
+/**
+ * @brief Get the wall-clock time in milliseconds, for PathLimits::max_ms deadlines.
+ *
+ * @return The current time in milliseconds.
+ */
+static inline uint64_t now_ms(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (uint64_t) ts.tv_sec * 1000u + (uint64_t) ts.tv_nsec / 1000000u;
+}
+
 /**
  * @struct Coord
  *
@@ -147,14 +198,117 @@ typedef struct {
  * @struct CoordList
  *
  * @brief CoordList structure representing a list of coordinates.
- * It contains a dynamic array of coordinates
- * and the count of coordinates.
+ * It contains a dynamic array of coordinates,
+ * the count of coordinates and the allocated capacity.
  */
 typedef struct {
     Coord *coord;     /* dynamic array */
     size_t count;
+    size_t cap;       /* allocated capacity */
 } CoordList;
 
+/**
+ * @struct Region
+ *
+ * @brief Region structure representing a rectangular block of map cells.
+ * It contains the top-left cell and the size of the block.
+ */
+typedef struct {
+    int32_t row0;        /* row of the top-left cell            */
+    int32_t col0;        /* column of the top-left cell         */
+    int32_t rows;        /* block height                        */
+    int32_t cols;        /* block width                         */
+} Region;
+
+/**
+ * @struct VertexPair
+ *
+ * @brief VertexPair structure representing a pair of vertex indices (a < b).
+ */
+typedef struct {
+    size_t a;
+    size_t b;
+} VertexPair;
+
+/**
+ * @struct PairList
+ *
+ * @brief PairList structure representing a list of vertex pairs.
+ * It contains a dynamic array of pairs,
+ * the count of pairs and the allocated capacity.
+ */
+typedef struct {
+    VertexPair *pair; /* dynamic array */
+    size_t count;
+    size_t cap;       /* allocated capacity */
+} PairList;
+
+/**
+ * @brief Free the resources of a pair list and reset it to empty.
+ * @param list Pointer to the list to be freed.
+ */
+void pair_list_free(PairList *list);
+
+/**
+ * @brief Initialize an empty coordinate list.
+ * @param list Pointer to the list to be initialized.
+ */
+void coord_list_init(CoordList *list);
+
+/**
+ * @brief Append a coordinate to the list, growing it geometrically.
+ * @param list Pointer to the list.
+ * @param c Coordinate to append.
+ *
+ * @return Status code indicating success or failure.
+ */
+Status coord_list_push(CoordList *list, Coord c);
+
+/**
+ * @brief Free the resources of a coordinate list and reset it to empty.
+ * @param list Pointer to the list to be freed.
+ */
+void coord_list_free(CoordList *list);
+
+/**
+ * Number of distinct frequency values (one per char value).
+ */
+#define FREQ_SLOTS 256
+
+/**
+ * @struct FreqBuckets
+ *
+ * @brief FreqBuckets structure grouping vertex indices by frequency.
+ * The vertices of frequency f are idx[start[f] .. start[f + 1]),
+ * with f taken as an unsigned char.
+ */
+typedef struct {
+    size_t start[FREQ_SLOTS + 1];  /* bucket offsets into idx       */
+    size_t *idx;                   /* vertex indices, grouped       */
+} FreqBuckets;
+
+/**
+ * @brief Get the vertex indices of one frequency.
+ * @param b Pointer to the buckets.
+ * @param freq Frequency of the bucket.
+ *
+ * @return Pointer to the first index of the bucket.
+ */
+static inline const size_t *freq_bucket(const FreqBuckets *b, char freq) {
+    return b->idx + b->start[(unsigned char) freq];
+}
+
+/**
+ * @brief Get the number of vertices of one frequency.
+ * @param b Pointer to the buckets.
+ * @param freq Frequency of the bucket.
+ *
+ * @return The bucket size.
+ */
+static inline size_t freq_bucket_size(const FreqBuckets *b, char freq) {
+    return b->start[(unsigned char) freq + 1] - b->start[(unsigned char) freq];
+}
+
 /**
  * @brief Initialize a graph with a given capacity.
  * @param g Pointer to the graph to be initialized.
@@ -209,8 +363,68 @@ Status graph_insert_vertex(Graph *g, char freq, int row, int col);
  */
 Status graph_remove_vertex(Graph *g, size_t idx);
 
+/**
+ * @brief Change the frequency of a vertex.
+ * @details The vertex keeps its index. Its edges to the antennas of the old
+ * frequency are replaced by edges to those of the new one, and a current danger
+ * index is updated for both frequencies in O(k).
+ * @param g Pointer to the graph.
+ * @param idx Index of the vertex.
+ * @param freq New frequency.
+ *
+ * @return Status code indicating success or failure.
+ */
+Status graph_retune_vertex(Graph *g, size_t idx, char freq);
+
+/**
+ * @brief Get the connected component of a vertex.
+ * @details Components come from a union-find (path compression, union by rank)
+ * that is kept up to date as vertices and edges are added. After a removal the
+ * sets are rebuilt from the adjacency lists on the next query. The component id
+ * is the index of a representative vertex and stays valid until the graph changes.
+ * @param g Pointer to the graph.
+ * @param v Vertex index.
+ * @param comp Pointer to store the component id.
+ *
+ * @return Status code indicating success or failure.
+ */
+Status graph_component_of(Graph *g, size_t v, size_t *comp);
+
+/**
+ * @brief Get the number of vertices in the component of a vertex.
+ * @param g Pointer to the graph.
+ * @param v Vertex index.
+ * @param size Pointer to store the component size.
+ *
+ * @return Status code indicating success or failure.
+ */
+Status graph_component_size(Graph *g, size_t v, size_t *size);
+
+/**
+ * @brief Get the number of connected components of the graph.
+ * @param g Pointer to the graph.
+ * @param count Pointer to store the component count.
+ *
+ * @return Status code indicating success or failure.
+ */
+Status graph_component_count(Graph *g, size_t *count);
+
+/**
+ * @brief Check whether there is a path between two vertices.
+ * @details Amortised O(1): two union-find lookups instead of a traversal.
+ * @param g Pointer to the graph.
+ * @param a First vertex index.
+ * @param b Second vertex index.
+ * @param reachable Pointer to store the result.
+ *
+ * @return Status code indicating success or failure.
+ */
+Status graph_reachable(Graph *g, size_t a, size_t b, bool *reachable);
+
 /**
  * @brief Load a graph from a matrix file.
+ * @details The number of lines and the longest line of the file are recorded
+ * as the map size (Graph::rows, Graph::cols).
  * @param g Pointer to the graph to be loaded.
  * @param path Path to the matrix file.
  *
@@ -218,6 +432,62 @@ Status graph_remove_vertex(Graph *g, size_t idx);
  */
 Status graph_from_matrix_file(Graph **g, const char *path);
 
+/**
+ * @brief Group the vertex indices of the graph by frequency (counting sort, O(n)).
+ * @param g Pointer to the graph.
+ * @param out Pointer to the FreqBuckets to be filled.
+ *
+ * @return Status code indicating success or failure.
+ */
+Status graph_freq_buckets(const Graph *g, FreqBuckets *out);
+
+/**
+ * @brief Free the resources of a FreqBuckets structure.
+ * @param b Pointer to the buckets to be freed.
+ */
+void freq_buckets_free(FreqBuckets *b);
+
+/**
+ * @struct TraversalWorkspace
+ *
+ * @brief TraversalWorkspace structure holding the scratch arrays of DFS, BFS and all-paths.
+ * A vertex is visited when its mark equals the current epoch, so starting a
+ * new traversal only increments the epoch instead of clearing the marks.
+ * Arrays grow to fit the graph they are used on and are kept for reuse.
+ */
+typedef struct {
+    size_t cap;          /* vertices mark and next can hold     */
+    uint32_t epoch;      /* stamp of the current traversal      */
+    uint32_t *mark;      /* epoch at which each vertex was seen */
+    size_t *stack;       /* DFS stack, BFS queue or path buffer */
+    size_t stack_cap;    /* allocated stack entries             */
+    EdgeNode **next;     /* next edge to try at each path depth */
+} TraversalWorkspace;
+
+/**
+ * @brief Initialize a traversal workspace for graphs of up to n vertices.
+ * @param ws Pointer to the workspace to be initialized.
+ * @param n Expected number of vertices.
+ *
+ * @return Status code indicating success or failure.
+ */
+Status traversal_workspace_init(TraversalWorkspace *ws, size_t n);
+
+/**
+ * @brief Grow a traversal workspace so that it fits a graph of n vertices.
+ * @param ws Pointer to the workspace.
+ * @param n Number of vertices.
+ *
+ * @return Status code indicating success or failure.
+ */
+Status traversal_workspace_reserve(TraversalWorkspace *ws, size_t n);
+
+/**
+ * @brief Free the resources of a traversal workspace.
+ * @param ws Pointer to the workspace to be freed.
+ */
+void traversal_workspace_free(TraversalWorkspace *ws);
+
 /**
  * @brief Depth-first search starting at vertex index start.
  * @param g Pointer to the graph.
@@ -229,6 +499,20 @@ Status graph_from_matrix_file(Graph **g, const char *path);
  */
 Status graph_dfs(const Graph *g, size_t start, VisitFn fn, void *ctx);
 
+/**
+ * @brief Depth-first search using a reusable workspace.
+ * @details Same visit order as graph_dfs(); it allocates nothing once the
+ * workspace has grown to fit the graph.
+ * @param g Pointer to the graph.
+ * @param start Starting vertex index.
+ * @param fn Function to be called for each visited vertex.
+ * @param ctx Context pointer to be passed to the function.
+ * @param ws Pointer to the workspace.
+ *
+ * @return Status code indicating success or failure.
+ */
+Status graph_dfs_ws(const Graph *g, size_t start, VisitFn fn, void *ctx, TraversalWorkspace *ws);
+
 /**
  * @brief Breadth-first search starting at vertex index start.
  * @param g Pointer to the graph.
@@ -240,8 +524,23 @@ Status graph_dfs(const Graph *g, size_t start, VisitFn fn, void *ctx);
  */
 Status graph_bfs(const Graph *g, size_t start, VisitFn fn, void *ctx);
 
+/**
+ * @brief Breadth-first search using a reusable workspace.
+ * @details Same visit order as graph_bfs(), without allocating.
+ * @param g Pointer to the graph.
+ * @param start Starting vertex index.
+ * @param fn Function to be called for each visited vertex.
+ * @param ctx Context pointer to be passed to the function.
+ * @param ws Pointer to the workspace.
+ *
+ * @return Status code indicating success or failure.
+ */
+Status graph_bfs_ws(const Graph *g, size_t start, VisitFn fn, void *ctx, TraversalWorkspace *ws);
+
 /**
  * @brief Find all paths from src to dst in the graph.
+ * @details Collects the paths streamed by graph_for_each_path(), growing the
+ * set geometrically. Free the result with path_set_free().
  * @param g Pointer to the graph.
  * @param src Source vertex index.
  * @param dst Destination vertex index.
@@ -251,8 +550,87 @@ Status graph_bfs(const Graph *g, size_t start, VisitFn fn, void *ctx);
  */
 Status graph_all_paths(const Graph *g, size_t src, size_t dst, PathSet *out);
 
+/**
+ * @brief Find all paths from src to dst using a reusable traversal workspace.
+ * @param g Pointer to the graph.
+ * @param src Source vertex index.
+ * @param dst Destination vertex index.
+ * @param out Pointer to the PathSet to store the found paths.
+ * @param ws Pointer to the workspace.
+ *
+ * @return Status code indicating success or failure.
+ */
+Status graph_all_paths_ws(const Graph *g, size_t src, size_t dst, PathSet *out, TraversalWorkspace *ws);
+
+/**
+ * @brief Stream every simple path from src to dst to a callback.
+ * @details The search is an iterative DFS over a single path buffer, so no
+ * path is copied or stored. It stops when fn returns STATUS_STOP or when one
+ * of the limits is reached.
+ * @param g Pointer to the graph.
+ * @param src Source vertex index.
+ * @param dst Destination vertex index.
+ * @param limits Optional limits, NULL for none.
+ * @param fn Callback receiving each path.
+ * @param ctx User context passed to the callback.
+ * @param truncated Optional output, true if the search stopped before visiting every path.
+ *
+ * @return Status code indicating success or failure.
+ */
+Status graph_for_each_path(const Graph *g, size_t src, size_t dst, const PathLimits *limits,
+                           PathFn fn, void *ctx, bool *truncated);
+
+/**
+ * @brief Stream every simple path from src to dst using a reusable traversal workspace.
+ * @details Same as graph_for_each_path(), without allocating.
+ * @param g Pointer to the graph.
+ * @param src Source vertex index.
+ * @param dst Destination vertex index.
+ * @param limits Optional limits, NULL for none.
+ * @param fn Callback receiving each path.
+ * @param ctx User context passed to the callback.
+ * @param truncated Optional output, true if the search stopped before visiting every path.
+ * @param ws Pointer to the workspace.
+ *
+ * @return Status code indicating success or failure.
+ */
+Status graph_for_each_path_ws(const Graph *g, size_t src, size_t dst, const PathLimits *limits,
+                              PathFn fn, void *ctx, bool *truncated, TraversalWorkspace *ws);
+
+/**
+ * @brief Free the paths of a PathSet.
+ * @param ps Pointer to the PathSet to be freed.
+ */
+void path_set_free(PathSet *ps);
+
+/**
+ * Largest non-complete component graph_count_paths() counts with its subset DP.
+ */
+#define PATH_COUNT_DP_MAX 16
+
+/**
+ * @brief Count the simple paths from src to dst without enumerating them.
+ * @details When the component of src is complete (a frequency clique of k
+ * vertices), the count is the sum of falling factorials
+ * sum_{j=0}^{k-2} (k-2)! / (k-2-j)!, computed in O(k). Other components of
+ * up to PATH_COUNT_DP_MAX vertices are counted with a memoised DP over the
+ * visited subsets. The count saturates at UINT64_MAX.
+ * @param g Pointer to the graph.
+ * @param src Source vertex index.
+ * @param dst Destination vertex index.
+ * @param count Pointer to store the number of paths.
+ * @param saturated Optional output, true if the real count exceeds UINT64_MAX.
+ *
+ * @return Status code indicating success or failure
+ * (STATUS_UNSUPPORTED for a larger non-complete component).
+ */
+Status graph_count_paths(const Graph *g, size_t src, size_t dst, uint64_t *count, bool *saturated);
+
 /**
  * @brief Find all intersections between two frequencies in the graph.
+ * @details Hash join: the cells of the smaller frequency bucket are hashed and
+ * the larger bucket probes them, so the cost is linear in the two bucket sizes.
+ * A cell is reported once per co-located (A, B) antenna pair.
  * @param g Pointer to the graph.
  * @param freqA First frequency.
  * @param freqB Second frequency.
@@ -262,6 +640,17 @@ Status graph_all_paths(const Graph *g, size_t src, size_t dst, PathSet *out);
  */
 Status graph_intersections(const Graph *g, char freqA, char freqB, CoordList *out);
 
+/**
+ * @brief Find every pair of co-located antennas with different frequencies.
+ * @details All cells are hashed once; only the antennas that share a cell are
+ * then grouped, so the cost is linear in the vertex count plus the output.
+ * @param g Pointer to the graph.
+ * @param out Pointer to the PairList to store the pairs (a < b), grouped by cell.
+ *
+ * @return Status code indicating success or failure.
+ */
+Status graph_colocated_pairs(const Graph *g, PairList *out);
+
 /**
  * @brief Find all dangerous points for a given frequency.
  * @param g Pointer to the graph.
@@ -270,11 +659,136 @@ Status graph_intersections(const Graph *g, char freqA, char freqB, CoordList *ou
  * @param count Pointer to store the count of dangerous points.
  *
  * @return Status code indicating success or failure.
+ *
+ * @deprecated The caller cannot pass the capacity of danger, so the array may overflow.
+ * Use graph_danger_points() instead.
  */
 Status compute_danger_points(const Graph *g, char freq, Coord *danger, size_t *count);
 
+/**
+ * @brief Find all dangerous points for a given frequency.
+ * @details Every pair of same-frequency antennas produces two points at twice
+ * their distance. Only points inside the map are generated: pairs that cannot
+ * put either point inside are skipped without being visited. Points are
+ * deduplicated through a hash set, so the total cost is proportional to the
+ * number of same-frequency pairs.
+ * @param g Pointer to the graph.
+ * @param freq Frequency to check for dangerous points.
+ * @param out Pointer to the CoordList to store the dangerous points.
+ *
+ * @return Status code indicating success or failure.
+ */
+Status graph_danger_points(const Graph *g, char freq, CoordList *out);
+
+/**
+ * @brief qsort comparator ordering coordinates by row, then column.
+ * @param a Pointer to the first Coord.
+ * @param b Pointer to the second Coord.
+ *
+ * @return Negative, zero or positive, as for qsort().
+ */
+int coord_compare_rows(const void *a, const void *b);
+
+/**
+ * @brief Get the highest partner row that can still put an antinode inside the map.
+ * @details For a partner b at or below anchor a, the antinode 2a - b needs
+ * b.row <= 2 a.row, and the antinode 2b - a needs b.row <= (rows - 1 + a.row) / 2.
+ * @param row Row of the anchor antenna.
+ * @param rows Map height.
+ *
+ * @return The row limit.
+ */
+static inline int64_t partner_row_limit(int64_t row, int64_t rows) {
+    int64_t twice = 2 * row;
+    int64_t sum = rows - 1 + row;
+    int64_t half = sum >= 0 ? sum / 2 : -((1 - sum) / 2);
+    return twice > half ? twice : half;
+}
+
+/**
+ * Function pointer type receiving one antinode from anchor_antinodes().
+ * The cell may lie outside the map; the function filters it.
+ */
+typedef Status (*AntinodeFn)(int64_t row, int64_t col, void *ctx);
+
+/**
+ * @brief Pass both antinodes of every pair formed by an anchor and its later partners.
+ * @details The coordinates must be sorted with coord_compare_rows(), so the scan
+ * of partners stops at the first one past partner_row_limit(). Pairs of stacked
+ * antennas are skipped. Being inline, a call with a constant fn compiles to a
+ * direct call.
+ * @param pts Coordinates of one frequency, sorted by row.
+ * @param a Index of the anchor.
+ * @param end One past the last partner.
+ * @param rows Map height.
+ * @param fn Function receiving each antinode.
+ * @param ctx Context pointer to pass to the function.
+ *
+ * @return STATUS_OK, or the first error returned by fn.
+ */
+static inline Status anchor_antinodes(const Coord *pts, size_t a, size_t end, int32_t rows,
+                                      AntinodeFn fn, void *ctx) {
+    int64_t limit = partner_row_limit(pts[a].row, rows);
+    Status st = STATUS_OK;
+    for (size_t b = a + 1; b < end && st == STATUS_OK; ++b) {
+        if (pts[b].row > limit) break;
+        int64_t dr = (int64_t) pts[b].row - pts[a].row;
+        int64_t dc = (int64_t) pts[b].col - pts[a].col;
+        if (dr == 0 && dc == 0) continue; // skip same point
+
+        // Extend in both directions by the distance between antennas
+        st = fn(pts[a].row - dr, pts[a].col - dc, ctx);
+        if (st == STATUS_OK) st = fn(pts[b].row + dr, pts[b].col + dc, ctx);
+    }
+    return st;
+}
+
+/**
+ * @brief Get the greatest common divisor of two non-negative integers.
+ * @param a First value.
+ * @param b Second value.
+ *
+ * @return gcd(a, b).
+ */
+static inline int64_t gcd64(int64_t a, int64_t b) {
+    while (b) {
+        int64_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+/**
+ * @brief Mix a 64-bit key (splitmix64 finalizer) to spread it over a hash table.
+ * @param k Key.
+ *
+ * @return The hash value.
+ */
+static inline uint64_t mix64(uint64_t k) {
+    k ^= k >> 30;
+    k *= 0xbf58476d1ce4e5b9ULL;
+    k ^= k >> 27;
+    k *= 0x94d049bb133111ebULL;
+    k ^= k >> 31;
+    return k;
+}
+
+/**
+ * @brief qsort comparator ordering (size, freq) pairs by decreasing bucket size.
+ * @param a Pointer to the first size_t[2] pair.
+ * @param b Pointer to the second size_t[2] pair.
+ *
+ * @return Negative, zero or positive, as for qsort().
+ */
+static inline int bucket_compare_size(const void *a, const void *b) {
+    const size_t *x = a, *y = b;
+    return (x[0] < y[0]) - (x[0] > y[0]);
+}
+
 /**
  * @brief Find all dangerous point intersections between two frequencies.
+ * @details Only points inside the map are considered.
  * @param g Pointer to the graph.
  * @param freqA First frequency.
  * @param freqB Second frequency.
@@ -0,0 +1,118 @@
+/**
+ * @file network.h
+ * @brief Header file for the analysis of single-frequency antenna networks.
+ *
+ * @details
+ * All antennas of one frequency form a clique in the graph. The functions
+ * in this file work on such a network directly from the vertex coordinates,
+ * without materialising its O(k^2) edges.
+ *
+ * @author Ahmet Abdullah GULTEKIN
+ * @date 2025-05-25
+ */
+
+#ifndef PRACTICALWORK_NETWORK_H
+#define PRACTICALWORK_NETWORK_H
+
+#pragma once //the same
+
+#include <stddef.h> /* size_t */
+#include "../include/graph.h"
+#include "../include/paths.h"
+
+/**
+ * Networks with fewer antennas than this are spanned on the calling thread.
+ */
+#define MST_PARALLEL_MIN 2048
+
+/**
+ * @struct SpanningTree
+ *
+ * @brief SpanningTree structure holding a minimum spanning tree.
+ * The edges are listed in the order Prim's algorithm adds them.
+ */
+typedef struct {
+    VertexPair *edge;    /* tree edges, as graph vertex indices */
+    size_t count;        /* number of edges                     */
+    double length;       /* total length of the edges           */
+} SpanningTree;
+
+/**
+ * @brief Compute the minimum spanning tree of the antennas of one frequency.
+ * @details Dense Prim on the implicit complete graph of the k antennas, in
+ * O(k^2) time and O(k) memory. For large networks each step is split over a
+ * team of threads: every worker updates the candidate distances of its share of
+ * the antennas and reports its nearest one, and the nearest overall is taken by
+ * a min-reduction. Ties go to the lowest vertex index, so the tree does not
+ * depend on the worker count.
+ * @param g Pointer to the graph.
+ * @param freq Frequency of the network.
+ * @param metric Length of an edge.
+ * @param n_workers Number of worker threads (0 for one per processor).
+ * @param out Pointer to the SpanningTree to be filled.
+ *
+ * @return Status code indicating success or failure
+ * (STATUS_NOT_FOUND if there is no antenna with this frequency).
+ */
+Status graph_freq_mst(const Graph *g, char freq, Metric metric, size_t n_workers, SpanningTree *out);
+
+/**
+ * @brief Free the resources of a SpanningTree.
+ * @param t Pointer to the SpanningTree to be freed.
+ */
+void spanning_tree_free(SpanningTree *t);
+
+/**
+ * Fewest antennas on a line for graph_collinear() to report it.
+ */
+#define COLLINEAR_MIN 3
+
+/**
+ * @struct CollinearSet
+ *
+ * @brief CollinearSet structure holding the antennas of one frequency that lie on one line.
+ */
+typedef struct {
+    char freq;           /* frequency of the antennas           */
+    size_t count;        /* number of antennas on the line      */
+    size_t *idx;         /* graph vertex indices, increasing    */
+} CollinearSet;
+
+/**
+ * @struct CollinearSets
+ *
+ * @brief CollinearSets structure holding the result of graph_collinear().
+ * The index arrays of all sets are slices of one shared buffer.
+ */
+typedef struct {
+    CollinearSet *set;   /* sets, by frequency then by first antenna */
+    size_t count;        /* number of sets                      */
+    size_t *members;     /* storage of the index arrays         */
+} CollinearSets;
+
+/**
+ * @brief Find every line holding at least min_points antennas of the same frequency.
+ * @details Each antenna of a frequency is taken in turn as the anchor, and the
+ * later antennas are grouped in a hash table by the reduced direction
+ * (dr/gcd, dc/gcd) towards them, so a frequency of k antennas costs O(k^2)
+ * instead of the O(k^3) of testing every triple. A line is reported from its
+ * first antenna only, which sees all the others; the lines already reported are
+ * kept in a second hash table keyed by direction and intercept. Every set is
+ * therefore maximal and listed once. Antennas stacked on one cell belong to
+ * every line through it. Frequencies are tasks on the thread pool.
+ * @param g Pointer to the graph.
+ * @param min_points Fewest antennas per line, at least COLLINEAR_MIN.
+ * @param n_workers Number of worker threads (0 for one per processor).
+ * @param out Pointer to the CollinearSets to be filled.
+ *
+ * @return Status code indicating success or failure.
+ */
+Status graph_collinear(const Graph *g, size_t min_points, size_t n_workers, CollinearSets *out);
+
+/**
+ * @brief Free the resources of a CollinearSets structure.
+ * @param s Pointer to the CollinearSets to be freed.
+ */
+void collinear_sets_free(CollinearSets *s);
+
+#endif //PRACTICALWORK_NETWORK_H
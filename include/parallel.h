@@ -0,0 +1,106 @@
+/**
+ * @file parallel.h
+ * @brief Header file for the fork-join thread pool used by the analysis functions.
+ *
+ * @details
+ * The pool is built on the C11 <threads.h> API. Tasks are numbered
+ * 0..n_tasks-1 and handed out dynamically, so uneven tasks (for example
+ * frequencies with very different antenna counts) still balance well.
+ * The calling thread takes part in the work as worker 0.
+ *
+ * @author Ahmet Abdullah GULTEKIN
+ * @date 2025-05-25
+ */
+
+#ifndef PRACTICALWORK_PARALLEL_H
+#define PRACTICALWORK_PARALLEL_H
+
+#pragma once //the same
+
+#include <stddef.h> /* size_t */
+#include "../include/graph.h"
+
+/**
+ * Function pointer type for a parallel task.
+ * @p task is the task number, @p worker the index of the executing worker
+ * (always below the worker count passed to parallel_for()), so it can be
+ * used to address per-thread buffers.
+ * Returning anything other than STATUS_OK stops the remaining tasks.
+ */
+typedef Status (*TaskFn)(size_t task, size_t worker, void *ctx);
+
+/**
+ * @brief Get the number of workers used when the caller passes 0.
+ *
+ * @return The number of online processors (at least 1).
+ */
+size_t parallel_default_workers(void);
+
+/**
+ * @brief Resolve a requested worker count for a given number of tasks.
+ * @param n_workers Requested worker count (0 for the default).
+ * @param n_tasks Number of tasks to be run.
+ *
+ * @return The worker count parallel_for() will actually use (at least 1).
+ */
+size_t parallel_worker_count(size_t n_workers, size_t n_tasks);
+
+/**
+ * @brief Run n_tasks tasks on a pool of worker threads and wait for them.
+ * @param n_tasks Number of tasks.
+ * @param n_workers Number of workers (0 for the default).
+ * @param fn Task function.
+ * @param ctx Context pointer to be passed to the task function.
+ *
+ * @return STATUS_OK, or the first error returned by a task or by thread creation.
+ */
+Status parallel_for(size_t n_tasks, size_t n_workers, TaskFn fn, void *ctx);
+
+/**
+ * @brief Run n_tasks tasks with work stealing and wait for them.
+ * @details Each worker owns a deque seeded with a contiguous block of task
+ * numbers and runs it from the front; a worker whose deque is empty steals
+ * from the back of another one. Neighbouring tasks thus tend to run on the
+ * same worker, and uneven tasks are still balanced.
+ * @param n_tasks Number of tasks.
+ * @param n_workers Number of workers (0 for the default).
+ * @param fn Task function.
+ * @param ctx Context pointer to be passed to the task function.
+ *
+ * @return STATUS_OK, or the first error returned by a task or by thread creation.
+ */
+Status parallel_for_steal(size_t n_tasks, size_t n_workers, TaskFn fn, void *ctx);
+
+/**
+ * Opaque state of a parallel_team() call, passed to team_barrier().
+ */
+typedef struct Team Team;
+
+/**
+ * Function pointer type for a team worker.
+ * Every worker runs the function once, concurrently with the others;
+ * @p worker is in 0..n_workers-1. Every worker must reach the same
+ * sequence of team_barrier() calls.
+ */
+typedef Status (*TeamFn)(Team *team, size_t worker, size_t n_workers, void *ctx);
+
+/**
+ * @brief Run a worker function on a team of threads that execute concurrently.
+ * @details Unlike parallel_for(), the workers are alive for the whole call, so
+ * they can synchronise in rounds with team_barrier(). If a thread cannot be
+ * created the team is smaller; the actual size is passed to every worker.
+ * @param n_workers Number of workers (0 for the default).
+ * @param fn Worker function.
+ * @param ctx Context pointer to be passed to the worker function.
+ *
+ * @return STATUS_OK, or the first error returned by a worker.
+ */
+Status parallel_team(size_t n_workers, TeamFn fn, void *ctx);
+
+/**
+ * @brief Wait until every worker of the team has reached the barrier.
+ * @param team Team passed to the worker function.
+ */
+void team_barrier(Team *team);
+
+#endif //PRACTICALWORK_PARALLEL_H
@@ -0,0 +1,153 @@
+/**
+ * @file paths.h
+ * @brief Header file for the parallel and weighted path search functions.
+ *
+ * @details
+ * graph_for_each_path() walks the search tree on a single core. The
+ * functions in this file split that tree into independent subtrees and
+ * run them on the work-stealing pool of parallel.h, and find weighted
+ * shortest paths (Dijkstra and A*) without enumerating any path.
+ *
+ * @author Ahmet Abdullah GULTEKIN
+ * @date 2025-05-25
+ */
+
+#ifndef PRACTICALWORK_PATHS_H
+#define PRACTICALWORK_PATHS_H
+
+#pragma once //the same
+
+#include <stddef.h> /* size_t */
+#include <stdint.h> /* uint32_t */
+#include <stdbool.h>
+#include <math.h>   /* sqrt, fabs */
+#include "../include/graph.h"
+
+/**
+ * Number of subtrees generated per worker when splitting the search tree.
+ */
+#define PATH_TASKS_PER_WORKER 16
+
+/**
+ * @brief Stream every simple path from src to dst to a callback, in parallel.
+ * @details The first levels of the search tree are expanded into path prefixes,
+ * and each prefix is a task on parallel_for_steal(). Every worker keeps its own
+ * visited bitmap and path stack and writes the paths of a task into a private
+ * buffer, which is handed to fn under a lock, so fn is never called concurrently.
+ * With @p ordered the buffers are released in task order and fn receives the
+ * paths in the same order as graph_for_each_path(); a task whose buffer fills
+ * up before its turn waits for it, so memory stays bounded. Otherwise a buffer
+ * is released as soon as it fills up or its task ends.
+ * @param g Pointer to the graph.
+ * @param src Source vertex index.
+ * @param dst Destination vertex index.
+ * @param limits Optional limits, NULL for none (max_paths counts delivered paths).
+ * @param n_workers Number of worker threads (0 for one per processor).
+ * @param ordered Deliver the paths in sequential DFS order.
+ * @param fn Callback receiving each path.
+ * @param ctx User context passed to the callback.
+ * @param truncated Optional output, true if the search stopped before visiting every path.
+ *
+ * @return Status code indicating success or failure.
+ */
+Status graph_for_each_path_parallel(const Graph *g, size_t src, size_t dst, const PathLimits *limits,
+                                    size_t n_workers, bool ordered, PathFn fn, void *ctx, bool *truncated);
+
+/**
+ * @enum Metric
+ *
+ * @brief Distance used as the weight of an edge between two antennas.
+ */
+typedef enum {
+    METRIC_EUCLIDEAN = 0,  /* straight-line distance              */
+    METRIC_MANHATTAN       /* |row difference| + |col difference| */
+} Metric;
+
+/**
+ * @brief Get the distance between two antennas under a metric.
+ * @param a First vertex.
+ * @param b Second vertex.
+ * @param metric Metric to use.
+ *
+ * @return The distance.
+ */
+static inline double metric_dist(const Vertex *a, const Vertex *b, Metric metric) {
+    double dr = (double) a->row - b->row;
+    double dc = (double) a->col - b->col;
+    if (metric == METRIC_MANHATTAN) return fabs(dr) + fabs(dc);
+    return sqrt(dr * dr + dc * dc);
+}
+
+/**
+ * @struct PathWorkspace
+ *
+ * @brief PathWorkspace structure holding the scratch arrays of a shortest-path search.
+ * It can be reused across searches; entries are validated with an epoch
+ * stamp, so a new search does not have to clear the arrays.
+ */
+typedef struct {
+    size_t cap;          /* vertices the arrays can hold          */
+    uint32_t epoch;      /* stamp of the current search           */
+    uint32_t *stamp;     /* search that last touched each vertex  */
+    double *dist;        /* best known cost from the source       */
+    double *key;         /* heap key: dist plus the heuristic     */
+    size_t *prev;        /* predecessor on the best known path    */
+    size_t *pos;         /* heap slot, SIZE_MAX once settled      */
+    size_t *heap;        /* binary min-heap of vertex indices     */
+    size_t size;         /* vertices in the heap                  */
+} PathWorkspace;
+
+/**
+ * @brief Initialize a workspace for graphs of up to n vertices.
+ * @details The workspace grows by itself when used on a larger graph.
+ * @param ws Pointer to the workspace to be initialized.
+ * @param n Expected number of vertices.
+ *
+ * @return Status code indicating success or failure.
+ */
+Status path_workspace_init(PathWorkspace *ws, size_t n);
+
+/**
+ * @brief Free the resources of a workspace.
+ * @param ws Pointer to the workspace to be freed.
+ */
+void path_workspace_free(PathWorkspace *ws);
+
+/**
+ * @brief Find the cheapest path from src to dst with Dijkstra's algorithm.
+ * @details Edge weights are the distance between the two antennas under
+ * @p metric, computed on the fly from Vertex::row and Vertex::col.
+ * @param g Pointer to the graph.
+ * @param src Source vertex index.
+ * @param dst Destination vertex index.
+ * @param metric Edge weight.
+ * @param ws Optional workspace to reuse, NULL for a temporary one.
+ * @param out Pointer to the Path to be filled; free out->idx when done.
+ * @param cost Optional output, the total weight of the path.
+ *
+ * @return Status code indicating success or failure
+ * (STATUS_NOT_FOUND if dst cannot be reached).
+ */
+Status graph_dijkstra(const Graph *g, size_t src, size_t dst, Metric metric,
+                      PathWorkspace *ws, Path *out, double *cost);
+
+/**
+ * @brief Find the cheapest path from src to dst with A*.
+ * @details Same result as graph_dijkstra(). The distance to dst under the same
+ * metric is a consistent heuristic, so fewer vertices are settled when the
+ * antennas are spread out.
+ * @param g Pointer to the graph.
+ * @param src Source vertex index.
+ * @param dst Destination vertex index.
+ * @param metric Edge weight and heuristic.
+ * @param ws Optional workspace to reuse, NULL for a temporary one.
+ * @param out Pointer to the Path to be filled; free out->idx when done.
+ * @param cost Optional output, the total weight of the path.
+ *
+ * @return Status code indicating success or failure
+ * (STATUS_NOT_FOUND if dst cannot be reached).
+ */
+Status graph_astar(const Graph *g, size_t src, size_t dst, Metric metric,
+                   PathWorkspace *ws, Path *out, double *cost);
+
+#endif //PRACTICALWORK_PATHS_H
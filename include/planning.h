@@ -0,0 +1,141 @@
+/**
+ * @file planning.h
+ * @brief Header file for the antenna planning tools.
+ *
+ * @details
+ * The functions in this file search for changes to the antenna layout that
+ * keep the danger low, scoring each option by the danger it would add
+ * rather than recomputing the danger of the whole map.
+ *
+ * @author Ahmet Abdullah GULTEKIN
+ * @date 2025-05-25
+ */
+
+#ifndef PRACTICALWORK_PLANNING_H
+#define PRACTICALWORK_PLANNING_H
+
+#pragma once //the same
+
+#include <stddef.h> /* size_t */
+#include <stdint.h> /* uint64_t */
+#include "../include/graph.h"
+
+/**
+ * @enum PlacementGoal
+ *
+ * @brief What a placement should add the least of; the other count breaks ties.
+ */
+typedef enum {
+    PLACE_FEWEST_CELLS = 0,  /* new danger cells of the frequency      */
+    PLACE_FEWEST_OVERLAPS    /* new cells already dangerous for others */
+} PlacementGoal;
+
+/**
+ * @struct Placement
+ *
+ * @brief Placement structure holding a candidate cell and the danger an antenna there would add.
+ */
+typedef struct {
+    Coord cell;          /* candidate cell                      */
+    size_t new_cells;    /* in-map cells that become dangerous  */
+    size_t new_overlaps; /* of those, cells dangerous for another frequency */
+} Placement;
+
+/**
+ * @brief Find the best free cells for a new antenna of a given frequency.
+ * @details The danger of the graph is computed once into bitsets. A candidate
+ * is then scored against the antennas of its frequency alone: each of the k
+ * pairs it would form adds two antinodes, which count when they are inside the
+ * map and not already dangerous for the frequency, so a candidate costs O(k).
+ * Candidate rows are tasks on the thread pool, and every worker keeps its best
+ * n_best candidates in a bounded heap. Ties go to the first cell in row-major order.
+ * @param g Pointer to the graph.
+ * @param freq Frequency of the new antenna.
+ * @param region Optional block of candidate cells, NULL for the whole map;
+ * it is clipped to the map and cells holding an antenna are skipped.
+ * @param goal Count to minimise first.
+ * @param n_best Number of placements wanted (at least 1).
+ * @param n_workers Number of worker threads (0 for one per processor).
+ * @param out Output array of n_best placements, best first.
+ * @param count Pointer to store the number of placements written.
+ *
+ * @return Status code indicating success or failure.
+ */
+Status graph_best_placements(const Graph *g, char freq, const Region *region, PlacementGoal goal,
+                             size_t n_best, size_t n_workers, Placement *out, size_t *count);
+
+/**
+ * @enum ReassignGoal
+ *
+ * @brief What a frequency reassignment should minimise.
+ */
+typedef enum {
+    REASSIGN_DANGER_CELLS = 0, /* cells dangerous for any frequency      */
+    REASSIGN_OVERLAPS          /* cells dangerous for two or more        */
+} ReassignGoal;
+
+/**
+ * Moves tried by each chain when ReassignParams::steps is 0.
+ */
+#define REASSIGN_STEPS 100000
+
+/**
+ * Initial annealing temperature when ReassignParams::t_start is 0.
+ */
+#define REASSIGN_T_START 2.0
+
+/**
+ * Final annealing temperature when ReassignParams::t_end is 0.
+ */
+#define REASSIGN_T_END 0.05
+
+/**
+ * @struct ReassignParams
+ *
+ * @brief ReassignParams structure holding the settings of graph_reassign_freqs().
+ * A zero field takes its default.
+ */
+typedef struct {
+    ReassignGoal goal;
+    const char *freqs;   /* more frequencies antennas may take  */
+    size_t n_freqs;      /* entries in freqs                    */
+    size_t steps;        /* moves tried by each chain           */
+    size_t chains;       /* independent chains (0 for one per worker) */
+    double t_start;      /* initial temperature                 */
+    double t_end;        /* final temperature                   */
+    uint64_t seed;       /* random seed; chains derive their own */
+} ReassignParams;
+
+/**
+ * @struct ReassignResult
+ *
+ * @brief ReassignResult structure holding the outcome of graph_reassign_freqs().
+ */
+typedef struct {
+    size_t before;       /* goal value of the initial assignment */
+    size_t after;        /* goal value of the written assignment */
+    size_t changed;      /* antennas given a new frequency      */
+} ReassignResult;
+
+/**
+ * @brief Retune antennas to minimise the danger cells or the overlaps of the map.
+ * @details Simulated annealing over the frequency of every antenna, starting
+ * from the current ones. A move retunes one antenna to another frequency: the
+ * pairs it leaves and the pairs it joins update reference-counted (frequency,
+ * cell) antinode counts held in CoordSet hit counts, so a move costs O(k), its
+ * delta is exact, and a chain stores only the cells that are antinodes. Worse
+ * moves are accepted with probability exp(-delta / T), and T cools geometrically
+ * from t_start to t_end. Independent chains with their own seeds run on the
+ * thread pool; the best assignment found by any chain is written back with
+ * graph_retune_vertex().
+ * @param g Pointer to the graph.
+ * @param params Settings, NULL for the defaults. The antennas may take any
+ * frequency already in the graph or listed in params->freqs.
+ * @param n_workers Number of worker threads (0 for one per processor).
+ * @param out Optional pointer to the ReassignResult to be filled.
+ *
+ * @return Status code indicating success or failure.
+ */
+Status graph_reassign_freqs(Graph *g, const ReassignParams *params, size_t n_workers, ReassignResult *out);
+
+#endif //PRACTICALWORK_PLANNING_H
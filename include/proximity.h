@@ -0,0 +1,59 @@
+/**
+ * @file proximity.h
+ * @brief Header file for the proximity graph builder.
+ *
+ * @details
+ * The graph of graph.h only links antennas that share a frequency. The
+ * proximity graph links any two antennas that are at most a radius apart,
+ * whatever their frequency, and is stored in compressed sparse row form.
+ *
+ * @author Ahmet Abdullah GULTEKIN
+ * @date 2025-05-25
+ */
+
+#ifndef PRACTICALWORK_PROXIMITY_H
+#define PRACTICALWORK_PROXIMITY_H
+
+#pragma once //the same
+
+#include <stddef.h> /* size_t */
+#include "../include/graph.h"
+#include "../include/paths.h"
+
+/**
+ * @struct CsrGraph
+ *
+ * @brief CsrGraph structure holding an undirected graph in compressed sparse row form.
+ * The neighbours of vertex v are adj[offset[v]] .. adj[offset[v + 1] - 1], in
+ * increasing order; vertex numbers are the indices of the source Graph.
+ */
+typedef struct {
+    size_t n;            /* number of vertices                         */
+    size_t *offset;      /* n + 1 row offsets into adj                 */
+    size_t *adj;         /* neighbour lists (each edge appears twice)  */
+} CsrGraph;
+
+/**
+ * @brief Build the graph linking every pair of antennas at most radius apart.
+ * @details Antennas are bucketed into square cells of side ceil(radius), so
+ * only the 3x3 block of cells around an antenna has to be compared. Bucket
+ * rows are tasks on the thread pool: a first pass counts the neighbours of
+ * every antenna, a second one fills the lists in place, for O(n log n + E)
+ * work overall.
+ * @param g Pointer to the graph.
+ * @param radius Largest distance of a proximity edge.
+ * @param metric Distance used to compare with the radius.
+ * @param n_workers Number of worker threads (0 for one per processor).
+ * @param out Pointer to the CsrGraph to be filled.
+ *
+ * @return Status code indicating success or failure.
+ */
+Status graph_proximity(const Graph *g, double radius, Metric metric, size_t n_workers, CsrGraph *out);
+
+/**
+ * @brief Free the resources of a CsrGraph.
+ * @param c Pointer to the CsrGraph to be freed.
+ */
+void csr_graph_free(CsrGraph *c);
+
+#endif //PRACTICALWORK_PROXIMITY_H
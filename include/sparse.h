@@ -0,0 +1,198 @@
+/**
+ * @file sparse.h
+ * @brief Header file for the sparse 64-bit coordinate mode.
+ *
+ * @details
+ * Graph keeps int32 coordinates, explicit frequency cliques and, for the
+ * danger analysis, grids as large as the map. In the sparse mode coordinates
+ * are int64 and the map extent may be huge: antennas are a flat array,
+ * occupancy is a hash set, frequency cliques stay implicit in the frequency
+ * buckets, and danger cells come out as sorted, duplicate-free arrays. Memory
+ * is proportional to the antennas and their antinodes, never to the extent.
+ *
+ * @author Ahmet Abdullah GULTEKIN
+ * @date 2025-05-25
+ */
+
+#ifndef PRACTICALWORK_SPARSE_H
+#define PRACTICALWORK_SPARSE_H
+
+#pragma once //the same
+
+#include <stddef.h> /* size_t */
+#include <stdint.h> /* int64_t */
+#include <stdbool.h>
+#include "../include/graph.h"
+
+/**
+ * Largest magnitude of a sparse coordinate, so that antinodes (2a - b) never overflow.
+ */
+#define SPARSE_COORD_LIMIT ((int64_t) 1 << 61)
+
+/**
+ * @struct SparseCoord
+ *
+ * @brief SparseCoord structure representing a cell of the sparse map.
+ */
+typedef struct {
+    int64_t row;         /* row of the cell                     */
+    int64_t col;         /* column of the cell                  */
+} SparseCoord;
+
+/**
+ * @struct SparseAntenna
+ *
+ * @brief SparseAntenna structure representing an antenna of the sparse map.
+ */
+typedef struct {
+    char freq;           /* antenna frequency (printable ASCII) */
+    int64_t row;         /* row of the antenna                  */
+    int64_t col;         /* column of the antenna               */
+} SparseAntenna;
+
+/**
+ * @struct SparseSet
+ *
+ * @brief SparseSet structure representing an open-addressing hash set of sparse cells.
+ */
+typedef struct {
+    SparseCoord *keys;   /* stored cells                        */
+    uint8_t *used;       /* slot occupancy flags                */
+    size_t cap;          /* slot count (power of two)           */
+    size_t count;        /* number of stored cells              */
+} SparseSet;
+
+/**
+ * @struct SparseGraph
+ *
+ * @brief SparseGraph structure holding the antennas of a sparse map.
+ * The extent is either given by the input or the bounding box of the antennas,
+ * grown on every insertion. Antinodes outside it are ignored, as antinodes
+ * outside the matrix are for a Graph.
+ */
+typedef struct {
+    SparseAntenna *v;    /* antennas, in insertion order        */
+    size_t n;            /* number of antennas                  */
+    size_t cap;          /* allocated antennas                  */
+    SparseSet occupied;  /* cells holding at least one antenna  */
+    int64_t row0;        /* top row of the extent               */
+    int64_t col0;        /* left column of the extent           */
+    int64_t rows;        /* extent height (0 while empty)       */
+    int64_t cols;        /* extent width (0 while empty)        */
+    bool fixed;          /* extent given by the input           */
+} SparseGraph;
+
+/**
+ * @struct SparseCoordList
+ *
+ * @brief SparseCoordList structure holding sparse cells sorted by row, then column.
+ */
+typedef struct {
+    SparseCoord *coord;  /* sorted, duplicate-free cells        */
+    size_t count;        /* number of cells                     */
+} SparseCoordList;
+
+/**
+ * @brief Initialize an empty sparse graph.
+ * @param g Pointer to the graph to be initialized.
+ *
+ * @return Status code indicating success or failure.
+ */
+Status sparse_graph_init(SparseGraph *g);
+
+/**
+ * @brief Set the extent of the map; later insertions outside it are rejected.
+ * @param g Pointer to the graph; its antennas must lie inside the extent.
+ * @param row0 Top row.
+ * @param col0 Left column.
+ * @param rows Extent height (at least 1).
+ * @param cols Extent width (at least 1).
+ *
+ * @return Status code indicating success or failure.
+ */
+Status sparse_graph_set_extent(SparseGraph *g, int64_t row0, int64_t col0, int64_t rows, int64_t cols);
+
+/**
+ * @brief Add an antenna to a sparse graph.
+ * @param g Pointer to the graph.
+ * @param freq Frequency of the antenna.
+ * @param row Row of the antenna, at most SPARSE_COORD_LIMIT in magnitude.
+ * @param col Column of the antenna, at most SPARSE_COORD_LIMIT in magnitude.
+ *
+ * @return Status code indicating success or failure
+ * (STATUS_OVERFLOW beyond the coordinate limit, STATUS_INVALID outside a fixed extent).
+ */
+Status sparse_graph_insert(SparseGraph *g, char freq, int64_t row, int64_t col);
+
+/**
+ * @brief Load a sparse graph from a coordinate-list file.
+ * @details Every line holds "freq row col", the fields separated by blanks or
+ * commas. A line "extent row0 col0 rows cols" fixes the map extent, which is
+ * otherwise the bounding box of the antennas. Blank lines and lines starting
+ * with '#' are skipped.
+ * @param g Pointer to the graph to be initialized and filled.
+ * @param path Path to the coordinate-list file.
+ *
+ * @return Status code indicating success or failure.
+ */
+Status sparse_graph_load(SparseGraph *g, const char *path);
+
+/**
+ * @brief Check whether a cell holds an antenna, with one hash lookup.
+ * @param g Pointer to the graph.
+ * @param row Row of the cell.
+ * @param col Column of the cell.
+ *
+ * @return True if an antenna stands on the cell, false otherwise.
+ */
+bool sparse_graph_occupied(const SparseGraph *g, int64_t row, int64_t col);
+
+/**
+ * @brief Group the antenna indices of a sparse graph by frequency (counting sort, O(n)).
+ * @param g Pointer to the graph.
+ * @param out Pointer to the FreqBuckets to be filled.
+ *
+ * @return Status code indicating success or failure.
+ */
+Status sparse_graph_freq_buckets(const SparseGraph *g, FreqBuckets *out);
+
+/**
+ * @brief Compute the in-extent danger cells of some or all frequencies.
+ * @details Each frequency is a task on the thread pool, largest bucket first. A
+ * task writes the antinodes of its pairs to an array, then sorts it and drops the
+ * duplicates; the arrays of the frequencies are merged the same way. Memory
+ * follows the number of antinodes, whatever the extent.
+ * @param g Pointer to the graph.
+ * @param freqs Frequencies to check (duplicates are counted once), NULL for all of them.
+ * @param k Number of entries in freqs.
+ * @param n_workers Number of worker threads (0 for one per processor).
+ * @param out Pointer to the SparseCoordList to be filled.
+ *
+ * @return Status code indicating success or failure.
+ */
+Status sparse_danger_points(const SparseGraph *g, const char *freqs, size_t k, size_t n_workers,
+                            SparseCoordList *out);
+
+/**
+ * @brief Check whether a sorted list holds a cell, by binary search.
+ * @param l Pointer to the list.
+ * @param row Row of the cell.
+ * @param col Column of the cell.
+ *
+ * @return True if the cell is in the list, false otherwise.
+ */
+bool sparse_coord_list_contains(const SparseCoordList *l, int64_t row, int64_t col);
+
+/**
+ * @brief Free the resources of a SparseCoordList.
+ * @param l Pointer to the list to be freed.
+ */
+void sparse_coord_list_free(SparseCoordList *l);
+
+/**
+ * @brief Free the resources of a SparseGraph.
+ * @param g Pointer to the graph to be freed.
+ */
+void sparse_graph_free(SparseGraph *g);
+
+#endif //PRACTICALWORK_SPARSE_H
@@ -39,6 +39,7 @@ enum {
     STR_INFO_LISTS_CLEARED,
     STR_INFO_DANGER_POINTS,
     STR_INFO_DANGER_OVERLAPS,
+    STR_INFO_PATH_COUNT,
     STR_ERR_IO,
     STR_ERR_GRAPH_COULD_NOT_FIND,
     STR_ERR_GRAPH_COULD_NOT_CLEARED,
@@ -48,6 +49,7 @@ enum {
     STR_ERR_INVALID_CHOICE,
     STR_ERR_FREQUENCY_NOT_EQUAL,
     STR_ERR_INTERSECTIONS_NOT_FOUND,
+    STR_ERR_TOO_MANY_PATHS,
     STR_COUNT               /* number of strings */
 };
 
@@ -74,6 +76,7 @@ enum {
     * STR_INFO_PROMPT_AVAILABLE_FILES,
     * STR_INFO_PROMPT_FILE_CHOICE,
     * STR_INFO_LISTS_CLEARED,
+    * STR_INFO_PATH_COUNT,
     * STR_ERR_IO,
     * STR_ERR_GRAPH_COULD_NOT_FIND,
     * STR_ERR_GRAPH_COULD_NOT_CLEARED,
@@ -82,7 +85,8 @@ enum {
     * STR_ERR_NOT_IMPLEMENTED,
     * STR_ERR_INVALID_CHOICE,
     * STR_ERR_FREQUENCY_NOT_EQUAL,
-    * STR_ERR_INTERSECTIONS_NOT_FOUND
+    * STR_ERR_INTERSECTIONS_NOT_FOUND,
+    * STR_ERR_TOO_MANY_PATHS
     * @see STR_COUNT
     * @note The strings are used for displaying messages to the user and for error handling.
     */
@@ -110,6 +114,7 @@ static const char *const STR[STR_COUNT] = {
         "Listas limpas com sucesso.\n",
         "Pontos perigosos para a frequencia",
         "Interseccao de pontos perigosos para as frequencias",
+        "Numero de caminhos",
         "Erro E/S - nao foi possivel abrir o ficheiro\n",
         "Erro - o grafo nao foi encontrado\n",
         "Erro - o grafo nao pode ser limpo\n",
@@ -118,7 +123,8 @@ static const char *const STR[STR_COUNT] = {
         "Erro - funcionalidade nao implementada\n",
         "Opcao invalida, tente novamente\n",
         "Frequencias diferentes, tente novamente.\n",
-        "Interseccao nao encontrada.\n"
+        "Interseccao nao encontrada.\n",
+        "Demasiados caminhos para listar, apenas o numero e mostrado.\n"
 };
 
 /**
@@ -151,6 +157,7 @@ static const char *const STR[STR_COUNT] = {
         "Listeler basariyla temizlendi.\n",
         "Frekansi icin tehlike noktaları",
         "Frekanslar icin tehlike kesisimleri",
+        "Yol sayisi",
         "G/C hatasi - dosya acilamadi!\n",
         "Hata - Graf bulunamadi.\n",
         "Hata - Graf temizlenemedi.\n",
@@ -159,7 +166,8 @@ static const char *const STR[STR_COUNT] = {
         "Hata - ozellik uygulanamadi.\n",
         "Gecersiz secim, tekrar deneyiniz.\n",
         "Frekanslar esit degil, lutfen tekrar deneyin.\n",
-        "Kesisim bulunamadi.\n"
+        "Kesisim bulunamadi.\n",
+        "Listelenecek cok fazla yol var, sadece sayi gosteriliyor.\n"
 };
 
 /**
@@ -192,6 +200,7 @@ static const char *const STR[STR_COUNT] = {
         "Lists cleared successfully.\n",
         "Danger points for frequency",
         "Danger overlaps for frequencies",
+        "Number of paths",
         "I/O error - cannot open file\n",
         "Error - graph could not be found\n",
         "Error - graph could not be cleared\n",
@@ -200,7 +209,8 @@ static const char *const STR[STR_COUNT] = {
         "Error - feature not implemented\n",
         "Invalid choice, try again\n",
         "Frequencies are not equal, please try again.\n",
-        "Intersections not found.\n"
+        "Intersections not found.\n",
+        "Too many paths to list, showing the count only.\n"
 };
 #endif
 
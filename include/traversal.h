@@ -0,0 +1,83 @@
+/**
+ * @file traversal.h
+ * @brief Header file for the bitmap-based graph traversals.
+ *
+ * @details
+ * graph_dfs() and graph_bfs() walk the adjacency lists with a bool array
+ * and a queue. The traversals in this file keep the frontier and the
+ * visited set as bitmaps, which suits the dense frequency cliques of the
+ * antenna graph, where most vertices are reached in a single step.
+ *
+ * @author Ahmet Abdullah GULTEKIN
+ * @date 2025-05-25
+ */
+
+#ifndef PRACTICALWORK_TRAVERSAL_H
+#define PRACTICALWORK_TRAVERSAL_H
+
+#pragma once //the same
+
+#include <stddef.h> /* size_t */
+#include <stdint.h> /* uint32_t */
+#include "../include/graph.h"
+
+/**
+ * Level reported for vertices that cannot be reached from the start.
+ */
+#define BFS_UNREACHED UINT32_MAX
+
+/**
+ * Switch to bottom-up once the frontier has more than 1/BFS_ALPHA of the unexplored edges.
+ */
+#define BFS_ALPHA 14
+
+/**
+ * Switch back to top-down once the frontier has fewer than 1/BFS_BETA of the vertices.
+ */
+#define BFS_BETA 24
+
+/**
+ * @brief Direction-optimizing breadth-first search.
+ * @details Each level is expanded either top-down (the frontier scans its
+ * neighbours) or bottom-up (every unvisited vertex looks for a parent in the
+ * frontier and stops at the first one), choosing per level with Beamer's
+ * heuristic. Frontiers and the visited set are bitmaps. Vertices are reported
+ * level by level, in increasing index order within a level.
+ * @param g Pointer to the graph; its edges must be symmetric.
+ * @param start Starting vertex index.
+ * @param fn Optional function to call for each visited vertex.
+ * @param ctx Context pointer to pass to the function.
+ * @param level Optional output array of graph_vertex_count(g) entries receiving
+ * the distance of every vertex from start, BFS_UNREACHED if it is not reachable.
+ *
+ * @return Status code indicating success or failure.
+ */
+Status graph_bfs_do(const Graph *g, size_t start, VisitFn fn, void *ctx, uint32_t *level);
+
+/**
+ * Number of sources advanced together by graph_msbfs(), one bit lane each.
+ */
+#define MSBFS_LANES 64
+
+/**
+ * @brief Multi-source BFS: run a breadth-first search from many sources at once.
+ * @details Sources are grouped in batches of MSBFS_LANES. Inside a batch every
+ * vertex holds a 64-bit word with one bit per source, so one sweep over the
+ * adjacency lists advances all the searches of the batch by a level, and
+ * vertices shared by several searches are scanned once. Batches are tasks on
+ * the thread pool.
+ * @param g Pointer to the graph; its edges must be symmetric.
+ * @param sources Start vertex of each search.
+ * @param n_sources Number of searches.
+ * @param n_workers Number of worker threads (0 for one per processor).
+ * @param reached Optional output array of n_sources entries receiving the number
+ * of vertices each search reaches, its source included.
+ * @param dist Optional output array of n_sources * graph_vertex_count(g) entries;
+ * row i receives the hop distance of every vertex from sources[i], or BFS_UNREACHED.
+ *
+ * @return Status code indicating success or failure.
+ */
+Status graph_msbfs(const Graph *g, const size_t *sources, size_t n_sources, size_t n_workers,
+                   size_t *reached, uint32_t *dist);
+
+#endif //PRACTICALWORK_TRAVERSAL_H
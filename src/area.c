@@ -0,0 +1,232 @@
+/**
+ * @file area.c
+ * @brief Implementation of the summed-area table over the map.
+ *
+ * A load runs in two passes over the rows it refreshes. The first turns every
+ * row into its running prefix, independently per row; the second adds each
+ * row of sums to the one below it, independently per column. Both passes are
+ * split over the thread pool, and neither touches the rows above from_row.
+ *
+ * @author Ahmet Abdullah GULTEKIN
+ * @date 2025-05-25
+ *
+ * @see area.h for the header file containing the function prototypes.
+ */
+
+#include <stdlib.h>     /* calloc, free */
+#include "../include/area.h"
+#include "../include/parallel.h"
+
+/**
+ * @struct AreaJob
+ *
+ * @brief Shared state of one AreaTable load.
+ */
+typedef struct {
+    AreaTable *t;
+    const BitGrid *bits;      /* source when loading a bitset        */
+    const Heatmap *heat;      /* source when loading a heatmap       */
+    int32_t from_row;
+} AreaJob;
+
+/**
+ * @fn row_prefix_task
+ * @brief Writes the running prefix of each row of one block into the table.
+ * @param task Block number, counted from from_row.
+ * @param worker Index of the executing worker (unused).
+ * @param ctx Pointer to the AreaJob.
+ * @return Always STATUS_OK.
+ */
+static Status row_prefix_task(size_t task, size_t worker, void *ctx) {
+    (void) worker;
+    AreaJob *job = ctx;
+    AreaTable *t = job->t;
+    size_t w = (size_t) t->cols + 1;
+    int32_t lo = job->from_row + (int32_t) (task * AREA_ROW_BLOCK);
+    int32_t hi = t->rows - lo < AREA_ROW_BLOCK ? t->rows : lo + AREA_ROW_BLOCK;
+
+    for (int32_t r = lo; r < hi; ++r) {
+        uint64_t *out = t->sum + (size_t) (r + 1) * w + 1;
+        uint64_t run = 0;
+        if (job->heat) {
+            const uint32_t *in = job->heat->count + (size_t) r * (size_t) t->cols;
+            for (int32_t c = 0; c < t->cols; ++c) out[c] = run += in[c];
+            continue;
+        }
+        for (int32_t c = 0; c < t->cols; ++c) {
+            run += bitgrid_test(job->bits, r, c);
+            out[c] = run;
+        }
+    }
+    return STATUS_OK;
+}
+
+/**
+ * @fn column_sum_task
+ * @brief Accumulates the row prefixes of one block of columns down the refreshed rows.
+ * @param task Block number.
+ * @param worker Index of the executing worker (unused).
+ * @param ctx Pointer to the AreaJob.
+ * @return Always STATUS_OK.
+ */
+static Status column_sum_task(size_t task, size_t worker, void *ctx) {
+    (void) worker;
+    AreaJob *job = ctx;
+    AreaTable *t = job->t;
+    size_t w = (size_t) t->cols + 1;
+    size_t lo = 1 + task * AREA_COL_BLOCK;
+    size_t hi = w - lo < AREA_COL_BLOCK ? w : lo + AREA_COL_BLOCK;
+
+    for (int32_t r = job->from_row; r < t->rows; ++r) {
+        const uint64_t *above = t->sum + (size_t) r * w;
+        uint64_t *row = t->sum + (size_t) (r + 1) * w;
+        for (size_t c = lo; c < hi; ++c) row[c] += above[c];
+    }
+    return STATUS_OK;
+}
+
+/**
+ * @fn area_load
+ * @brief Recomputes the sums of the rows from from_row down.
+ * @param job Pointer to the AreaJob.
+ * @param n_workers Number of worker threads (0 for one per processor).
+ * @return Status indicating success or failure.
+ */
+static Status area_load(AreaJob *job, size_t n_workers) {
+    AreaTable *t = job->t;
+    if (job->from_row < 0) job->from_row = 0;
+    if (job->from_row >= t->rows || t->cols == 0) return STATUS_OK;
+
+    size_t rows = (size_t) (t->rows - job->from_row);
+    Status st = parallel_for((rows + AREA_ROW_BLOCK - 1) / AREA_ROW_BLOCK, n_workers, row_prefix_task, job);
+    if (st != STATUS_OK) return st;
+    return parallel_for(((size_t) t->cols + AREA_COL_BLOCK - 1) / AREA_COL_BLOCK, n_workers, column_sum_task, job);
+}
+
+/**
+ * @fn area_table_init
+ * @brief Initializes an all-zero table for a map.
+ * @param t Pointer to the table.
+ * @param rows Map height.
+ * @param cols Map width.
+ * @return Status indicating success or failure.
+ */
+Status area_table_init(AreaTable *t, int32_t rows, int32_t cols) {
+    if (!t || rows < 0 || cols < 0) return STATUS_INVALID;
+    t->rows = rows;
+    t->cols = cols;
+    t->sum = calloc(((size_t) rows + 1) * ((size_t) cols + 1), sizeof(uint64_t));
+    return t->sum ? STATUS_OK : STATUS_ALLOC;
+}
+
+/**
+ * @fn area_table_load_bits
+ * @brief Loads the cells of a bitset from a given row down.
+ * @param t Pointer to the table.
+ * @param b Bitset of the cells.
+ * @param from_row First row to reload.
+ * @param n_workers Number of worker threads (0 for one per processor).
+ * @return Status indicating success or failure.
+ */
+Status area_table_load_bits(AreaTable *t, const BitGrid *b, int32_t from_row, size_t n_workers) {
+    if (!t || !t->sum || !b) return STATUS_INVALID;
+    AreaJob job = {.t = t, .bits = b, .from_row = from_row};
+    return area_load(&job, n_workers);
+}
+
+/**
+ * @fn area_table_load_heatmap
+ * @brief Loads the pair counts of a heatmap from a given row down.
+ * @param t Pointer to the table.
+ * @param h Heatmap of the same size as the table.
+ * @param from_row First row to reload.
+ * @param n_workers Number of worker threads (0 for one per processor).
+ * @return Status indicating success or failure.
+ */
+Status area_table_load_heatmap(AreaTable *t, const Heatmap *h, int32_t from_row, size_t n_workers) {
+    if (!t || !t->sum || !h || h->rows != t->rows || h->cols != t->cols) return STATUS_INVALID;
+    if (!h->count && h->rows && h->cols) return STATUS_INVALID;
+    AreaJob job = {.t = t, .heat = h, .from_row = from_row};
+    return area_load(&job, n_workers);
+}
+
+/**
+ * @fn area_table_count
+ * @brief Sums the cells of a rectangle from four table entries.
+ * @param t Pointer to the table.
+ * @param r Rectangle, clipped to the map.
+ * @return The sum over the rectangle.
+ */
+uint64_t area_table_count(const AreaTable *t, const Region *r) {
+    if (!t || !t->sum || !r || r->rows <= 0 || r->cols <= 0) return 0;
+    int64_t r0 = r->row0 < 0 ? 0 : r->row0;
+    int64_t c0 = r->col0 < 0 ? 0 : r->col0;
+    int64_t r1 = (int64_t) r->row0 + r->rows;
+    int64_t c1 = (int64_t) r->col0 + r->cols;
+    if (r1 > t->rows) r1 = t->rows;
+    if (c1 > t->cols) c1 = t->cols;
+    if (r0 >= r1 || c0 >= c1) return 0;
+
+    size_t w = (size_t) t->cols + 1;
+    const uint64_t *top = t->sum + (size_t) r0 * w;
+    const uint64_t *bottom = t->sum + (size_t) r1 * w;
+    return bottom[c1] - bottom[c0] - top[c1] + top[c0];
+}
+
+/**
+ * @struct AreaQueryJob
+ *
+ * @brief Shared state of one area_table_count_batch() call.
+ */
+typedef struct {
+    const AreaTable *t;
+    const Region *r;
+    size_t n;
+    uint64_t *out;
+} AreaQueryJob;
+
+/**
+ * @fn area_query_task
+ * @brief Answers one chunk of AREA_QUERY_CHUNK rectangles.
+ * @param task Chunk number.
+ * @param worker Index of the executing worker (unused).
+ * @param ctx Pointer to the AreaQueryJob.
+ * @return Always STATUS_OK.
+ */
+static Status area_query_task(size_t task, size_t worker, void *ctx) {
+    (void) worker;
+    AreaQueryJob *job = ctx;
+    size_t lo = task * AREA_QUERY_CHUNK;
+    size_t hi = job->n - lo < AREA_QUERY_CHUNK ? job->n : lo + AREA_QUERY_CHUNK;
+    for (size_t i = lo; i < hi; ++i) job->out[i] = area_table_count(job->t, &job->r[i]);
+    return STATUS_OK;
+}
+
+/**
+ * @fn area_table_count_batch
+ * @brief Sums the cells of many rectangles.
+ * @param t Pointer to the table.
+ * @param r Rectangles.
+ * @param n Number of rectangles.
+ * @param n_workers Number of worker threads (0 for one per processor).
+ * @param out Output array of n sums.
+ * @return Status indicating success or failure.
+ */
+Status area_table_count_batch(const AreaTable *t, const Region *r, size_t n, size_t n_workers, uint64_t *out) {
+    if (!t || !t->sum || (n && (!r || !out))) return STATUS_INVALID;
+    AreaQueryJob job = {.t = t, .r = r, .n = n, .out = out};
+    return parallel_for((n + AREA_QUERY_CHUNK - 1) / AREA_QUERY_CHUNK, n_workers, area_query_task, &job);
+}
+
+/**
+ * @fn area_table_free
+ * @brief Frees the resources of an AreaTable.
+ * @param t Pointer to the table.
+ */
+void area_table_free(AreaTable *t) {
+    if (!t) return;
+    free(t->sum);
+    t->sum = NULL;
+    t->rows = 0;
+    t->cols = 0;
+}
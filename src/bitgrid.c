@@ -0,0 +1,157 @@
+/**
+ * @file bitgrid.c
+ * @brief Implementation of the bitset over a rectangular window of grid cells.
+ *
+ * @author Ahmet Abdullah GULTEKIN
+ * @date 2025-05-25
+ *
+ * @see bitgrid.h for the header file containing the function prototypes
+ * and data structures.
+ */
+
+#include <stdlib.h>     /* calloc, free */
+#include <string.h>     /* memset */
+#if defined(__AVX2__)
+#include <immintrin.h>  /* _mm256_and_si256 */
+#endif
+#include "../include/bitgrid.h"
+
+/**
+ * @fn bitgrid_init
+ * @brief Initializes an empty grid over a window.
+ * @param b Pointer to the grid.
+ * @param row0 Row of the top-left cell.
+ * @param col0 Column of the top-left cell.
+ * @param rows Window height.
+ * @param cols Window width.
+ * @return Status indicating success or failure.
+ */
+Status bitgrid_init(BitGrid *b, int32_t row0, int32_t col0, int32_t rows, int32_t cols) {
+    if (!b || rows < 0 || cols < 0) return STATUS_INVALID;
+    b->bits = NULL;
+    b->words = 0;
+    b->row0 = row0;
+    b->col0 = col0;
+    b->rows = rows;
+    b->cols = cols;
+
+    size_t cells = (size_t) rows * (size_t) cols;
+    if (cols != 0 && cells / (size_t) cols != (size_t) rows) return STATUS_OVERFLOW;
+    b->words = (cells + 63) / 64;
+    if (b->words == 0) return STATUS_OK;
+
+    b->bits = calloc(b->words, sizeof(uint64_t));
+    if (!b->bits) {
+        b->words = 0;
+        return STATUS_ALLOC;
+    }
+    return STATUS_OK;
+}
+
+/**
+ * @fn bitgrid_free
+ * @brief Frees the resources of a grid.
+ * @param b Pointer to the grid.
+ */
+void bitgrid_free(BitGrid *b) {
+    if (!b) return;
+    free(b->bits);
+    b->bits = NULL;
+    b->words = 0;
+    b->rows = 0;
+    b->cols = 0;
+}
+
+/**
+ * @fn bitgrid_clear
+ * @brief Clears every cell of a grid.
+ * @param b Pointer to the grid.
+ */
+void bitgrid_clear(BitGrid *b) {
+    if (b && b->bits) memset(b->bits, 0, b->words * sizeof(uint64_t));
+}
+
+/**
+ * @fn same_window
+ * @brief Checks whether two grids cover the same window.
+ * @param a Pointer to the first grid.
+ * @param b Pointer to the second grid.
+ * @return True if the windows are equal, false otherwise.
+ */
+static inline bool same_window(const BitGrid *a, const BitGrid *b) {
+    return a->row0 == b->row0 && a->col0 == b->col0 && a->rows == b->rows && a->cols == b->cols;
+}
+
+/**
+ * @fn bitgrid_or
+ * @brief Merges src into dst word by word.
+ * @param dst Pointer to the destination grid.
+ * @param src Pointer to the source grid.
+ * @return Status indicating success or failure.
+ */
+Status bitgrid_or(BitGrid *dst, const BitGrid *src) {
+    if (!dst || !src || !same_window(dst, src)) return STATUS_INVALID;
+
+    for (size_t w = 0; w < dst->words; ++w) dst->bits[w] |= src->bits[w];
+    return STATUS_OK;
+}
+
+/**
+ * @fn bitgrid_and
+ * @brief Intersects src into dst word by word (four words at a time with AVX2).
+ * @param dst Pointer to the destination grid.
+ * @param src Pointer to the source grid.
+ * @return Status indicating success or failure.
+ */
+Status bitgrid_and(BitGrid *dst, const BitGrid *src) {
+    if (!dst || !src || !same_window(dst, src)) return STATUS_INVALID;
+
+    size_t w = 0;
+#if defined(__AVX2__)
+    for (; w + 4 <= dst->words; w += 4) {
+        __m256i a = _mm256_loadu_si256((const __m256i *) (dst->bits + w));
+        __m256i b = _mm256_loadu_si256((const __m256i *) (src->bits + w));
+        _mm256_storeu_si256((__m256i *) (dst->bits + w), _mm256_and_si256(a, b));
+    }
+#endif
+    for (; w < dst->words; ++w) dst->bits[w] &= src->bits[w];
+    return STATUS_OK;
+}
+
+/**
+ * @fn bitgrid_count
+ * @brief Counts the set cells of a grid.
+ * @param b Pointer to the grid.
+ * @return The number of set cells.
+ */
+size_t bitgrid_count(const BitGrid *b) {
+    if (!b) return 0;
+    size_t c = 0;
+    for (size_t w = 0; w < b->words; ++w) c += bitgrid_popcount(b->bits[w]);
+    return c;
+}
+
+/**
+ * @fn bitgrid_to_list
+ * @brief Appends the set cells of a grid to a list in row-major order.
+ * @param b Pointer to the grid.
+ * @param out Pointer to the list.
+ * @return Status indicating success or failure.
+ */
+Status bitgrid_to_list(const BitGrid *b, CoordList *out) {
+    if (!b || !out) return STATUS_INVALID;
+
+    for (size_t w = 0; w < b->words; ++w) {
+        // Visit only the set bits of each word
+        for (uint64_t bits = b->bits[w]; bits; bits &= bits - 1) {
+            size_t i = w * 64 + bitgrid_lowest_bit(bits);
+            Coord c = {
+                    .row = (int32_t) (b->row0 + (int64_t) (i / (size_t) b->cols)),
+                    .col = (int32_t) (b->col0 + (int64_t) (i % (size_t) b->cols))
+            };
+            Status st = coord_list_push(out, c);
+            if (st != STATUS_OK) return st;
+        }
+    }
+    return STATUS_OK;
+}
@@ -0,0 +1,223 @@
+/**
+ * @file coord_set.c
+ * @brief Implementation of the open-addressing hash set of grid coordinates.
+ *
+ * The set stores each (row, col) pair packed into a 64-bit key and resolves
+ * collisions with linear probing. The table is kept at most half full, so
+ * lookups and insertions run in expected constant time.
+ *
+ * @author Ahmet Abdullah GULTEKIN
+ * @date 2025-05-25
+ *
+ * @see coord_set.h for the header file containing the function prototypes
+ * and data structures.
+ */
+
+#include <stdlib.h>     /* calloc, free */
+#include "../include/coord_set.h"
+
+/**
+ * @fn pack_coord
+ * @brief Packs a coordinate into a 64-bit key.
+ * @param c Coordinate to pack.
+ * @return The packed key.
+ */
+static inline uint64_t pack_coord(Coord c) {
+    return ((uint64_t) (uint32_t) c.row << 32) | (uint32_t) c.col;
+}
+
+/**
+ * @fn alloc_slots
+ * @brief Allocates an empty table with the given number of slots.
+ * @param s Pointer to the set.
+ * @param cap Slot count (power of two).
+ * @return Status indicating success or failure.
+ */
+static Status alloc_slots(CoordSet *s, size_t cap) {
+    s->keys = calloc(cap, sizeof(uint64_t));
+    s->hits = calloc(cap, sizeof(uint32_t));
+    s->used = calloc(cap, sizeof(uint8_t));
+    if (!s->keys || !s->hits || !s->used) {
+        free(s->keys);
+        free(s->hits);
+        free(s->used);
+        s->keys = NULL;
+        s->hits = NULL;
+        s->used = NULL;
+        return STATUS_ALLOC;
+    }
+    s->cap = cap;
+    s->count = 0;
+    return STATUS_OK;
+}
+
+/**
+ * @fn find_slot
+ * @brief Returns the slot holding a key, or the empty slot where it would go.
+ * @param s Pointer to the set.
+ * @param key Packed key.
+ * @return The slot index.
+ */
+static size_t find_slot(const CoordSet *s, uint64_t key) {
+    size_t mask = s->cap - 1;
+    size_t i = (size_t) mix64(key) & mask;
+    while (s->used[i] && s->keys[i] != key) i = (i + 1) & mask;
+    return i;
+}
+
+/**
+ * @fn place_key
+ * @brief Places a key in the table without growing it.
+ * @param s Pointer to the set.
+ * @param key Packed key.
+ * @param hits Insertions to add to the key.
+ * @return True if the key was not present before, false otherwise.
+ */
+static bool place_key(CoordSet *s, uint64_t key, uint32_t hits) {
+    size_t i = find_slot(s, key);
+    s->hits[i] += hits;
+    if (s->used[i]) return false;
+    s->used[i] = 1;
+    s->keys[i] = key;
+    s->count++;
+    return true;
+}
+
+/**
+ * @fn grow
+ * @brief Doubles the table size and reinserts every key.
+ * @param s Pointer to the set.
+ * @return Status indicating success or failure.
+ */
+static Status grow(CoordSet *s) {
+    if (s->cap > SIZE_MAX / 2) return STATUS_OVERFLOW;
+    CoordSet bigger;
+    Status st = alloc_slots(&bigger, s->cap * 2);
+    if (st != STATUS_OK) return st;
+
+    for (size_t i = 0; i < s->cap; ++i) {
+        if (s->used[i]) place_key(&bigger, s->keys[i], s->hits[i]);
+    }
+    coord_set_free(s);
+    *s = bigger;
+    return STATUS_OK;
+}
+
+/**
+ * @fn coord_set_init
+ * @brief Initializes a coordinate set sized for an expected number of keys.
+ * @param s Pointer to the set.
+ * @param expected Expected number of distinct coordinates.
+ * @return Status indicating success or failure.
+ */
+Status coord_set_init(CoordSet *s, size_t expected) {
+    if (!s) return STATUS_INVALID;
+    s->keys = NULL;
+    s->hits = NULL;
+    s->used = NULL;
+    s->cap = 0;
+    s->count = 0;
+
+    // Keep the load factor at or below one half
+    size_t cap = 16;
+    while (cap / 2 < expected) {
+        if (cap > SIZE_MAX / 2) return STATUS_OVERFLOW;
+        cap *= 2;
+    }
+    return alloc_slots(s, cap);
+}
+
+/**
+ * @fn coord_set_free
+ * @brief Frees the resources of a coordinate set.
+ * @param s Pointer to the set.
+ */
+void coord_set_free(CoordSet *s) {
+    if (!s) return;
+    free(s->keys);
+    free(s->hits);
+    free(s->used);
+    s->keys = NULL;
+    s->hits = NULL;
+    s->used = NULL;
+    s->cap = 0;
+    s->count = 0;
+}
+
+/**
+ * @fn coord_set_insert
+ * @brief Inserts a coordinate into the set, growing it if needed.
+ * @param s Pointer to the set.
+ * @param c Coordinate to insert.
+ * @param inserted Optional output, true if the coordinate was new.
+ * @return Status indicating success or failure.
+ */
+Status coord_set_insert(CoordSet *s, Coord c, bool *inserted) {
+    if (!s || !s->keys) return STATUS_INVALID;
+    if ((s->count + 1) * 2 > s->cap) {
+        Status st = grow(s);
+        if (st != STATUS_OK) return st;
+    }
+    bool added = place_key(s, pack_coord(c), 1);
+    if (inserted) *inserted = added;
+    return STATUS_OK;
+}
+
+/**
+ * @fn coord_set_release
+ * @brief Undoes one insertion of a coordinate, removing it once its count reaches zero.
+ * @param s Pointer to the set.
+ * @param c Coordinate to release.
+ * @param removed Optional output, true if the coordinate left the set.
+ * @return Status indicating success or failure.
+ */
+Status coord_set_release(CoordSet *s, Coord c, bool *removed) {
+    if (!s) return STATUS_INVALID;
+    if (removed) *removed = false;
+    if (!s->keys) return STATUS_NOT_FOUND;
+    size_t i = find_slot(s, pack_coord(c));
+    if (!s->used[i]) return STATUS_NOT_FOUND;
+    if (--s->hits[i] > 0) return STATUS_OK;
+
+    // Backward-shift deletion: pull later keys of the run into the hole
+    // unless their home slot lies cyclically between the hole and them
+    size_t mask = s->cap - 1;
+    s->used[i] = 0;
+    s->count--;
+    for (size_t j = (i + 1) & mask; s->used[j]; j = (j + 1) & mask) {
+        size_t home = (size_t) mix64(s->keys[j]) & mask;
+        if (((j - home) & mask) < ((j - i) & mask)) continue;
+        s->keys[i] = s->keys[j];
+        s->hits[i] = s->hits[j];
+        s->used[i] = 1;
+        s->used[j] = 0;
+        s->hits[j] = 0;
+        i = j;
+    }
+    if (removed) *removed = true;
+    return STATUS_OK;
+}
+
+/**
+ * @fn coord_set_contains
+ * @brief Checks whether a coordinate is in the set.
+ * @param s Pointer to the set.
+ * @param c Coordinate to look up.
+ * @return True if the coordinate is in the set, false otherwise.
+ */
+bool coord_set_contains(const CoordSet *s, Coord c) {
+    return coord_set_hits(s, c) > 0;
+}
+
+/**
+ * @fn coord_set_hits
+ * @brief Returns the number of times a coordinate was inserted.
+ * @param s Pointer to the set.
+ * @param c Coordinate to look up.
+ * @return The insertion count, 0 if absent.
+ */
+uint32_t coord_set_hits(const CoordSet *s, Coord c) {
+    if (!s || !s->keys) return 0;
+    size_t i = find_slot(s, pack_coord(c));
+    return s->used[i] ? s->hits[i] : 0;
+}
@@ -0,0 +1,1451 @@
+/**
+ * @file danger.c
+ * @brief Implementation of the bulk danger analysis over all frequencies.
+ *
+ * Every antinode of a pair (a, b) is 2a - b or 2b - a, so all of them lie in
+ * the bounding box of the antennas grown by its own size on each side. That
+ * box, clipped to the map, is used as the common window of all danger grids.
+ * Harmonics lines are unbounded, so they use the whole map as their window.
+ *
+ * @author Ahmet Abdullah GULTEKIN
+ * @date 2025-05-25
+ *
+ * @see danger.h for the header file containing the function prototypes
+ * and data structures.
+ */
+
+#include <stdio.h>      /* FILE, fprintf */
+#include <stdlib.h>     /* malloc, calloc, free, qsort */
+#include <string.h>     /* memset */
+#include "../include/danger.h"
+#include "../include/parallel.h"
+
+/**
+ * @struct DangerJob
+ *
+ * @brief Shared context of the per-frequency tasks of graph_danger_all().
+ */
+typedef struct {
+    const Graph *g;
+    const FreqBuckets *buckets;
+    DangerMap *map;
+    BitGrid *partial;    /* one union grid per worker (optional)    */
+} DangerJob;
+
+/**
+ * @fn danger_window
+ * @brief Computes the window that contains every in-map antinode of the graph.
+ * @param g Pointer to the graph (at least one vertex).
+ * @param row0 Output, row of the top-left cell.
+ * @param col0 Output, column of the top-left cell.
+ * @param rows Output, window height (0 if no antinode can be inside the map).
+ * @param cols Output, window width.
+ */
+static void danger_window(const Graph *g, int32_t *row0, int32_t *col0, int32_t *rows, int32_t *cols) {
+    int64_t min_r = g->v[0].row, max_r = g->v[0].row;
+    int64_t min_c = g->v[0].col, max_c = g->v[0].col;
+    for (size_t i = 1; i < g->n; ++i) {
+        if (g->v[i].row < min_r) min_r = g->v[i].row;
+        if (g->v[i].row > max_r) max_r = g->v[i].row;
+        if (g->v[i].col < min_c) min_c = g->v[i].col;
+        if (g->v[i].col > max_c) max_c = g->v[i].col;
+    }
+
+    // Antinodes box, clipped to the map
+    int64_t r0 = 2 * min_r - max_r, c0 = 2 * min_c - max_c;
+    int64_t r1 = 2 * max_r - min_r, c1 = 2 * max_c - min_c;
+    if (r0 < 0) r0 = 0;
+    if (c0 < 0) c0 = 0;
+    if (r1 > (int64_t) g->rows - 1) r1 = (int64_t) g->rows - 1;
+    if (c1 > (int64_t) g->cols - 1) c1 = (int64_t) g->cols - 1;
+
+    *row0 = (int32_t) r0;
+    *col0 = (int32_t) c0;
+    *rows = r1 >= r0 && c1 >= c0 ? (int32_t) (r1 - r0 + 1) : 0;
+    *cols = r1 >= r0 && c1 >= c0 ? (int32_t) (c1 - c0 + 1) : 0;
+}
+
+/**
+ * @fn sorted_bucket
+ * @brief Copies the coordinates of a frequency bucket and sorts them by row.
+ * @param g Pointer to the graph.
+ * @param idx Vertex indices of the bucket.
+ * @param k Bucket size.
+ * @param pts Output array of k coordinates.
+ */
+static void sorted_bucket(const Graph *g, const size_t *idx, size_t k, Coord *pts) {
+    for (size_t i = 0; i < k; ++i) {
+        pts[i] = (Coord) {.row = g->v[idx[i]].row, .col = g->v[idx[i]].col};
+    }
+    qsort(pts, k, sizeof(Coord), coord_compare_rows);
+}
+
+/**
+ * @fn mark_cell
+ * @brief Sets an antinode in a grid; cells outside its window are ignored.
+ * @param row Row of the antinode.
+ * @param col Column of the antinode.
+ * @param ctx Pointer to the BitGrid.
+ * @return Always STATUS_OK.
+ */
+static Status mark_cell(int64_t row, int64_t col, void *ctx) {
+    bitgrid_set(ctx, row, col);
+    return STATUS_OK;
+}
+
+/**
+ * @fn mark_pairs
+ * @brief Sets the in-map antinodes of every pair of a frequency bucket in a grid.
+ * @param pts Coordinates of the bucket, sorted by row.
+ * @param k Bucket size.
+ * @param rows Map height.
+ * @param grid Grid to mark; its window lies inside the map.
+ */
+static void mark_pairs(const Coord *pts, size_t k, int32_t rows, BitGrid *grid) {
+    for (size_t a = 0; a < k; ++a) anchor_antinodes(pts, a, k, rows, mark_cell, grid);
+}
+
+/**
+ * @fn danger_task
+ * @brief Task body of graph_danger_all(): one frequency per task.
+ * @param task Index of the frequency in the map.
+ * @param worker Index of the executing worker.
+ * @param ctx Pointer to the DangerJob.
+ * @return Status indicating success or failure.
+ */
+static Status danger_task(size_t task, size_t worker, void *ctx) {
+    DangerJob *job = ctx;
+    char f = job->map->freq[task];
+    BitGrid *grid = &job->map->grid[task];
+    size_t k = freq_bucket_size(job->buckets, f);
+    if (k < 2) return STATUS_OK;
+
+    Coord *pts = malloc(k * sizeof(Coord));
+    if (!pts) return STATUS_ALLOC;
+    sorted_bucket(job->g, freq_bucket(job->buckets, f), k, pts);
+
+    mark_pairs(pts, k, job->g->rows, grid);
+    free(pts);
+    return job->partial ? bitgrid_or(&job->partial[worker], grid) : STATUS_OK;
+}
+
+/**
+ * @fn graph_danger_all
+ * @brief Computes the danger cells of every frequency in parallel.
+ * @param g Pointer to the graph.
+ * @param n_workers Number of worker threads (0 for one per processor).
+ * @param out Pointer to the map to fill.
+ * @return Status indicating success or failure.
+ */
+Status graph_danger_all(const Graph *g, size_t n_workers, DangerMap *out) {
+    if (!g || !out) return STATUS_INVALID;
+    memset(out, 0, sizeof(*out));
+    if (g->n == 0) return STATUS_OK;
+
+    int32_t row0, col0, rows, cols;
+    danger_window(g, &row0, &col0, &rows, &cols);
+    Status st = bitgrid_init(&out->all, row0, col0, rows, cols);
+    if (st != STATUS_OK) return st;
+
+    FreqBuckets buckets;
+    st = graph_freq_buckets(g, &buckets);
+    if (st != STATUS_OK) {
+        danger_map_free(out);
+        return st;
+    }
+
+    // Schedule the largest buckets first so the pool stays balanced
+    size_t order[FREQ_SLOTS][2];
+    size_t nf = 0;
+    for (size_t f = 0; f < FREQ_SLOTS; ++f) {
+        size_t k = buckets.start[f + 1] - buckets.start[f];
+        if (k > 0) {
+            order[nf][0] = k;
+            order[nf][1] = f;
+            nf++;
+        }
+    }
+    qsort(order, nf, sizeof(order[0]), bucket_compare_size);
+
+    out->freq = malloc(nf * sizeof(char));
+    out->grid = calloc(nf, sizeof(BitGrid));
+    if (!out->freq || !out->grid) st = STATUS_ALLOC;
+    for (size_t t = 0; t < nf && st == STATUS_OK; ++t) {
+        out->freq[t] = (char) order[t][1];
+        st = bitgrid_init(&out->grid[t], row0, col0, rows, cols);
+        if (st == STATUS_OK) out->count++;
+    }
+
+    size_t workers = parallel_worker_count(n_workers, nf);
+    BitGrid *partial = calloc(workers, sizeof(BitGrid));
+    if (!partial && st == STATUS_OK) st = STATUS_ALLOC;
+    size_t n_partial = 0;
+    while (st == STATUS_OK && n_partial < workers) {
+        st = bitgrid_init(&partial[n_partial], row0, col0, rows, cols);
+        if (st == STATUS_OK) n_partial++;
+    }
+
+    if (st == STATUS_OK) {
+        DangerJob job = {.g = g, .buckets = &buckets, .map = out, .partial = partial};
+        st = parallel_for(nf, workers, danger_task, &job);
+    }
+
+    // Reduce the per-worker unions into the combined map
+    for (size_t w = 0; w < n_partial; ++w) {
+        if (st == STATUS_OK) st = bitgrid_or(&out->all, &partial[w]);
+        bitgrid_free(&partial[w]);
+    }
+    free(partial);
+    freq_buckets_free(&buckets);
+    if (st != STATUS_OK) danger_map_free(out);
+    return st;
+}
+
+/**
+ * Number of bit planes of the bit-sliced counter (counts up to FREQ_SLOTS).
+ */
+#define COUNT_PLANES 9
+
+/**
+ * @fn push_count
+ * @brief Appends a count to a growable array.
+ * @param arr Pointer to the array.
+ * @param n Pointer to the number of stored counts.
+ * @param cap Pointer to the allocated capacity.
+ * @param c Count to append.
+ * @return Status indicating success or failure.
+ */
+static Status push_count(uint32_t **arr, size_t *n, size_t *cap, uint32_t c) {
+    if (*n == *cap) {
+        size_t new_cap = *cap ? *cap * 2 : 16;
+        uint32_t *na = realloc(*arr, new_cap * sizeof(uint32_t));
+        if (!na) return STATUS_ALLOC;
+        *arr = na;
+        *cap = new_cap;
+    }
+    (*arr)[(*n)++] = c;
+    return STATUS_OK;
+}
+
+/**
+ * @fn threshold_cells
+ * @brief Emits the cells set in at least m of the grids, with their counts.
+ * @details For every word, the grids are added into COUNT_PLANES bit planes
+ * (plane p holds bit p of the 64 cell counters), then the planes are compared
+ * against m from the most significant plane down.
+ * @param grids Grids sharing one window.
+ * @param nf Number of grids.
+ * @param m Threshold.
+ * @param out Output list.
+ * @param counts Output counts (NULL if not requested).
+ * @return Status indicating success or failure.
+ */
+static Status threshold_cells(const BitGrid *grids, size_t nf, size_t m, CoordList *out, uint32_t **counts) {
+    const BitGrid *b = &grids[0];
+    size_t n_counts = 0, cap_counts = 0;
+
+    for (size_t w = 0; w < b->words; ++w) {
+        uint64_t plane[COUNT_PLANES] = {0};
+        for (size_t f = 0; f < nf; ++f) {
+            uint64_t carry = grids[f].bits[w];
+            for (size_t p = 0; p < COUNT_PLANES && carry; ++p) {
+                uint64_t next = plane[p] & carry;
+                plane[p] ^= carry;
+                carry = next;
+            }
+        }
+
+        uint64_t gt = 0, eq = ~(uint64_t) 0;
+        for (size_t p = COUNT_PLANES; p-- > 0;) {
+            if ((m >> p) & 1) {
+                eq &= plane[p];
+            } else {
+                gt |= eq & plane[p];
+                eq &= ~plane[p];
+            }
+        }
+
+        for (uint64_t hit = gt | eq; hit; hit &= hit - 1) {
+            unsigned bit = bitgrid_lowest_bit(hit);
+            size_t i = w * 64 + bit;
+
+            Coord c = {
+                    .row = (int32_t) (b->row0 + (int64_t) (i / (size_t) b->cols)),
+                    .col = (int32_t) (b->col0 + (int64_t) (i % (size_t) b->cols))
+            };
+            Status st = coord_list_push(out, c);
+            if (st == STATUS_OK && counts) {
+                uint32_t cnt = 0;
+                for (size_t p = 0; p < COUNT_PLANES; ++p) cnt |= (uint32_t) ((plane[p] >> bit) & 1) << p;
+                st = push_count(counts, &n_counts, &cap_counts, cnt);
+            }
+            if (st != STATUS_OK) return st;
+        }
+    }
+    return STATUS_OK;
+}
+
+/**
+ * @fn graph_danger_overlaps_multi
+ * @brief Finds the cells that are dangerous for at least m of the given frequencies.
+ * @param g Pointer to the graph.
+ * @param freqs Array of frequencies.
+ * @param k Number of entries in freqs.
+ * @param m Threshold (at least 1).
+ * @param n_workers Number of worker threads (0 for one per processor).
+ * @param out Pointer to the output list.
+ * @param counts Optional output array of per-cell counts.
+ * @return Status indicating success or failure.
+ */
+Status graph_danger_overlaps_multi(const Graph *g, const char *freqs, size_t k, size_t m,
+                                   size_t n_workers, CoordList *out, uint32_t **counts) {
+    if (!g || (!freqs && k) || !out || m == 0) return STATUS_INVALID;
+    coord_list_init(out);
+    if (counts) *counts = NULL;
+
+    // Distinct frequencies only
+    char sel[FREQ_SLOTS];
+    bool seen[FREQ_SLOTS] = {false};
+    size_t nf = 0;
+    for (size_t i = 0; i < k; ++i) {
+        unsigned char f = (unsigned char) freqs[i];
+        if (!seen[f]) {
+            seen[f] = true;
+            sel[nf++] = (char) f;
+        }
+    }
+    if (m > nf || g->n == 0) return STATUS_OK;
+
+    int32_t row0, col0, rows, cols;
+    danger_window(g, &row0, &col0, &rows, &cols);
+
+    FreqBuckets buckets;
+    Status st = graph_freq_buckets(g, &buckets);
+    if (st != STATUS_OK) return st;
+
+    BitGrid *grids = calloc(nf, sizeof(BitGrid));
+    size_t n_grids = 0;
+    if (!grids) st = STATUS_ALLOC;
+    while (st == STATUS_OK && n_grids < nf) {
+        st = bitgrid_init(&grids[n_grids], row0, col0, rows, cols);
+        if (st == STATUS_OK) n_grids++;
+    }
+
+    if (st == STATUS_OK) {
+        DangerMap sel_map = {.count = nf, .freq = sel, .grid = grids};
+        DangerJob job = {.g = g, .buckets = &buckets, .map = &sel_map, .partial = NULL};
+        st = parallel_for(nf, n_workers, danger_task, &job);
+    }
+
+    if (st == STATUS_OK && m == nf) {
+        // Every frequency required: a plain word-wise intersection
+        for (size_t f = 1; f < nf && st == STATUS_OK; ++f) st = bitgrid_and(&grids[0], &grids[f]);
+        if (st == STATUS_OK) st = bitgrid_to_list(&grids[0], out);
+        if (st == STATUS_OK && counts && out->count) {
+            *counts = malloc(out->count * sizeof(uint32_t));
+            if (!*counts) st = STATUS_ALLOC;
+            for (size_t i = 0; st == STATUS_OK && i < out->count; ++i) (*counts)[i] = (uint32_t) nf;
+        }
+    } else if (st == STATUS_OK) {
+        st = threshold_cells(grids, nf, m, out, counts);
+    }
+
+    for (size_t f = 0; f < n_grids; ++f) bitgrid_free(&grids[f]);
+    free(grids);
+    freq_buckets_free(&buckets);
+    if (st != STATUS_OK) {
+        coord_list_free(out);
+        if (counts) {
+            free(*counts);
+            *counts = NULL;
+        }
+    }
+    return st;
+}
+
+/**
+ * @struct HarmonicsJob
+ *
+ * @brief Shared context of the per-anchor tasks of graph_danger_harmonics().
+ */
+typedef struct {
+    const Graph *g;
+    const size_t *idx;   /* vertex indices of the frequency          */
+    size_t k;            /* bucket size                              */
+    BitGrid *partial;    /* one grid per worker                      */
+} HarmonicsJob;
+
+/**
+ * @fn floor_div
+ * @brief Integer division rounding toward negative infinity.
+ * @param a Dividend.
+ * @param b Divisor (non-zero).
+ * @return floor(a / b).
+ */
+static inline int64_t floor_div(int64_t a, int64_t b) {
+    int64_t q = a / b;
+    return (a % b != 0 && (a < 0) != (b < 0)) ? q - 1 : q;
+}
+
+/**
+ * @fn ceil_div
+ * @brief Integer division rounding toward positive infinity.
+ * @param a Dividend.
+ * @param b Divisor (non-zero).
+ * @return ceil(a / b).
+ */
+static inline int64_t ceil_div(int64_t a, int64_t b) {
+    return -floor_div(-a, b);
+}
+
+/**
+ * @fn step_range
+ * @brief Narrows [*tmin, *tmax] to the multipliers t with lo <= p + t * s <= hi.
+ * @param p Start coordinate.
+ * @param s Step (may be zero).
+ * @param lo Lowest allowed coordinate.
+ * @param hi Highest allowed coordinate.
+ * @param tmin In/out, lowest multiplier.
+ * @param tmax In/out, highest multiplier.
+ */
+static void step_range(int64_t p, int64_t s, int64_t lo, int64_t hi, int64_t *tmin, int64_t *tmax) {
+    int64_t a, b;
+    if (s == 0) {
+        if (p >= lo && p <= hi) return;
+        *tmin = 1;
+        *tmax = 0;
+        return;
+    }
+    if (s > 0) {
+        a = ceil_div(lo - p, s);
+        b = floor_div(hi - p, s);
+    } else {
+        a = ceil_div(hi - p, s);
+        b = floor_div(lo - p, s);
+    }
+    if (a > *tmin) *tmin = a;
+    if (b < *tmax) *tmax = b;
+}
+
+/**
+ * @fn walk_line
+ * @brief Sets every in-window cell of the line through two antennas, in reduced steps.
+ * @param vi First antenna.
+ * @param vj Second antenna.
+ * @param grid Grid to mark; its window is the map.
+ */
+static void walk_line(const Vertex *vi, const Vertex *vj, BitGrid *grid) {
+    int64_t dr = (int64_t) vj->row - vi->row;
+    int64_t dc = (int64_t) vj->col - vi->col;
+    if (dr == 0 && dc == 0) return; // skip same point
+
+    int64_t d = gcd64(dr < 0 ? -dr : dr, dc < 0 ? -dc : dc);
+    int64_t sr = dr / d, sc = dc / d;
+
+    // Solve for the multipliers that stay inside the map instead of probing
+    int64_t tmin = INT64_MIN, tmax = INT64_MAX;
+    step_range(vi->row, sr, grid->row0, (int64_t) grid->row0 + grid->rows - 1, &tmin, &tmax);
+    step_range(vi->col, sc, grid->col0, (int64_t) grid->col0 + grid->cols - 1, &tmin, &tmax);
+
+    for (int64_t t = tmin; t <= tmax; ++t) {
+        bitgrid_set(grid, vi->row + t * sr, vi->col + t * sc);
+    }
+}
+
+/**
+ * @fn harmonics_task
+ * @brief Task body of graph_danger_harmonics(): all pairs of one anchor antenna.
+ * @param task Position of the anchor in the bucket.
+ * @param worker Index of the executing worker.
+ * @param ctx Pointer to the HarmonicsJob.
+ * @return Always STATUS_OK.
+ */
+static Status harmonics_task(size_t task, size_t worker, void *ctx) {
+    HarmonicsJob *job = ctx;
+    const Vertex *vi = &job->g->v[job->idx[task]];
+    for (size_t b = task + 1; b < job->k; ++b) {
+        walk_line(vi, &job->g->v[job->idx[b]], &job->partial[worker]);
+    }
+    return STATUS_OK;
+}
+
+/**
+ * @fn graph_danger_harmonics
+ * @brief Computes the resonant-harmonics danger cells of one frequency.
+ * @param g Pointer to the graph.
+ * @param freq Frequency to check.
+ * @param n_workers Number of worker threads (0 for one per processor).
+ * @param out Pointer to the grid to initialize and fill.
+ * @return Status indicating success or failure.
+ */
+Status graph_danger_harmonics(const Graph *g, char freq, size_t n_workers, BitGrid *out) {
+    if (!g || !out) return STATUS_INVALID;
+    memset(out, 0, sizeof(*out));
+
+    int32_t rows = g->rows, cols = g->cols;
+    Status st = bitgrid_init(out, 0, 0, rows, cols);
+    if (st != STATUS_OK) return st;
+
+    size_t k = 0;
+    for (size_t i = 0; i < g->n; ++i) {
+        if (g->v[i].freq == freq) k++;
+    }
+    if (k < 2) return STATUS_OK;
+
+    size_t *idx = malloc(k * sizeof(size_t));
+    if (!idx) {
+        bitgrid_free(out);
+        return STATUS_ALLOC;
+    }
+    k = 0;
+    for (size_t i = 0; i < g->n; ++i) {
+        if (g->v[i].freq == freq) idx[k++] = i;
+    }
+
+    HarmonicsJob job = {.g = g, .idx = idx, .k = k, .partial = out};
+    size_t workers = k >= HARMONICS_PARALLEL_MIN ? parallel_worker_count(n_workers, k - 1) : 1;
+    if (workers == 1) {
+        for (size_t a = 0; a + 1 < k; ++a) harmonics_task(a, 0, &job);
+        free(idx);
+        return STATUS_OK;
+    }
+
+    // Worker 0 writes straight into out, the others into private grids
+    BitGrid *partial = calloc(workers, sizeof(BitGrid));
+    if (!partial) st = STATUS_ALLOC;
+    size_t n_partial = 0;
+    if (partial) partial[n_partial++] = *out;
+    while (st == STATUS_OK && n_partial < workers) {
+        st = bitgrid_init(&partial[n_partial], 0, 0, rows, cols);
+        if (st == STATUS_OK) n_partial++;
+    }
+
+    if (st == STATUS_OK) {
+        job.partial = partial;
+        st = parallel_for(k - 1, workers, harmonics_task, &job);
+    }
+    for (size_t w = 1; w < n_partial; ++w) {
+        if (st == STATUS_OK) st = bitgrid_or(out, &partial[w]);
+        bitgrid_free(&partial[w]);
+    }
+    free(partial);
+    free(idx);
+    if (st != STATUS_OK) bitgrid_free(out);
+    return st;
+}
+
+/**
+ * Number of anchors per heatmap task.
+ */
+#define HEATMAP_CHUNK 16
+
+/**
+ * Number of rows per heatmap reduction task.
+ */
+#define HEATMAP_ROW_BLOCK 64
+
+/**
+ * @struct HeatmapJob
+ *
+ * @brief Shared context of the tasks of graph_danger_heatmap().
+ */
+typedef struct {
+    const Coord *pts;         /* all antennas, grouped by frequency, groups sorted by row */
+    const size_t *group_end;  /* end of the group of each antenna                         */
+    size_t n;                 /* number of antennas                                       */
+    int32_t rows;             /* map height                                               */
+    int32_t cols;             /* map width                                                */
+    uint32_t **partial;       /* one counter grid per worker                              */
+    size_t n_partial;         /* number of counter grids                                  */
+} HeatmapJob;
+
+/**
+ * @struct HeatmapGrid
+ *
+ * @brief Counter grid of one worker and the job it belongs to.
+ */
+typedef struct {
+    const HeatmapJob *job;
+    uint32_t *grid;
+} HeatmapGrid;
+
+/**
+ * @fn bump
+ * @brief Increments a counter cell if it lies inside the map.
+ * @param row Row of the cell.
+ * @param col Column of the cell.
+ * @param ctx Pointer to the HeatmapGrid.
+ * @return Always STATUS_OK.
+ */
+static Status bump(int64_t row, int64_t col, void *ctx) {
+    HeatmapGrid *h = ctx;
+    if (row < 0 || row >= h->job->rows || col < 0 || col >= h->job->cols) return STATUS_OK;
+    h->grid[(size_t) row * (size_t) h->job->cols + (size_t) col]++;
+    return STATUS_OK;
+}
+
+/**
+ * @fn heatmap_task
+ * @brief Task body of graph_danger_heatmap(): the pairs of HEATMAP_CHUNK anchors.
+ * @param task Chunk number.
+ * @param worker Index of the executing worker.
+ * @param ctx Pointer to the HeatmapJob.
+ * @return Always STATUS_OK.
+ */
+static Status heatmap_task(size_t task, size_t worker, void *ctx) {
+    HeatmapJob *job = ctx;
+    HeatmapGrid h = {.job = job, .grid = job->partial[worker]};
+    size_t end = (task + 1) * HEATMAP_CHUNK < job->n ? (task + 1) * HEATMAP_CHUNK : job->n;
+
+    for (size_t a = task * HEATMAP_CHUNK; a < end; ++a) {
+        anchor_antinodes(job->pts, a, job->group_end[a], job->rows, bump, &h);
+    }
+    return STATUS_OK;
+}
+
+/**
+ * @fn heatmap_reduce_task
+ * @brief Reduction task: sums the worker grids into grid 0 for one block of rows.
+ * @param task Row block number.
+ * @param worker Index of the executing worker (unused).
+ * @param ctx Pointer to the HeatmapJob.
+ * @return Always STATUS_OK.
+ */
+static Status heatmap_reduce_task(size_t task, size_t worker, void *ctx) {
+    (void) worker;
+    HeatmapJob *job = ctx;
+    size_t from = task * HEATMAP_ROW_BLOCK * (size_t) job->cols;
+    size_t rows_left = (size_t) job->rows - task * HEATMAP_ROW_BLOCK;
+    size_t to = from + (rows_left < HEATMAP_ROW_BLOCK ? rows_left : HEATMAP_ROW_BLOCK) * (size_t) job->cols;
+
+    uint32_t *dst = job->partial[0];
+    for (size_t w = 1; w < job->n_partial; ++w) {
+        const uint32_t *src = job->partial[w];
+        for (size_t i = from; i < to; ++i) dst[i] += src[i];
+    }
+    return STATUS_OK;
+}
+
+/**
+ * @fn graph_danger_heatmap
+ * @brief Counts, for every map cell, the same-frequency pairs that put an antinode on it.
+ * @param g Pointer to the graph.
+ * @param n_workers Number of worker threads (0 for one per processor).
+ * @param out Pointer to the heatmap to fill.
+ * @return Status indicating success or failure.
+ */
+Status graph_danger_heatmap(const Graph *g, size_t n_workers, Heatmap *out) {
+    if (!g || !out) return STATUS_INVALID;
+    out->rows = g->rows;
+    out->cols = g->cols;
+    size_t cells = (size_t) g->rows * (size_t) g->cols;
+    out->count = calloc(cells ? cells : 1, sizeof(uint32_t));
+    if (!out->count) return STATUS_ALLOC;
+    if (g->n < 2 || cells == 0) return STATUS_OK;
+
+    FreqBuckets buckets;
+    Status st = graph_freq_buckets(g, &buckets);
+    if (st != STATUS_OK) {
+        heatmap_free(out);
+        return st;
+    }
+
+    // Lay the buckets out one after the other, each sorted by row
+    Coord *pts = malloc(g->n * sizeof(Coord));
+    size_t *group_end = malloc(g->n * sizeof(size_t));
+    if (!pts || !group_end) st = STATUS_ALLOC;
+    for (size_t f = 0; f < FREQ_SLOTS && st == STATUS_OK; ++f) {
+        size_t from = buckets.start[f], to = buckets.start[f + 1];
+        sorted_bucket(g, buckets.idx + from, to - from, pts + from);
+        for (size_t i = from; i < to; ++i) group_end[i] = to;
+    }
+
+    size_t n_tasks = (g->n + HEATMAP_CHUNK - 1) / HEATMAP_CHUNK;
+    size_t workers = parallel_worker_count(n_workers, n_tasks);
+    uint32_t **partial = calloc(workers, sizeof(uint32_t *));
+    size_t n_partial = 0;
+    if (!partial && st == STATUS_OK) st = STATUS_ALLOC;
+    if (st == STATUS_OK) partial[n_partial++] = out->count; // worker 0 counts in place
+    while (st == STATUS_OK && n_partial < workers) {
+        partial[n_partial] = calloc(cells, sizeof(uint32_t));
+        if (!partial[n_partial]) st = STATUS_ALLOC;
+        else n_partial++;
+    }
+
+    HeatmapJob job = {
+            .pts = pts, .group_end = group_end, .n = g->n,
+            .rows = g->rows, .cols = g->cols,
+            .partial = partial, .n_partial = n_partial
+    };
+    if (st == STATUS_OK) st = parallel_for(n_tasks, workers, heatmap_task, &job);
+    if (st == STATUS_OK && n_partial > 1) {
+        size_t blocks = ((size_t) g->rows + HEATMAP_ROW_BLOCK - 1) / HEATMAP_ROW_BLOCK;
+        st = parallel_for(blocks, n_workers, heatmap_reduce_task, &job);
+    }
+
+    for (size_t w = 1; w < n_partial; ++w) free(partial[w]);
+    free(partial);
+    free(pts);
+    free(group_end);
+    freq_buckets_free(&buckets);
+    if (st != STATUS_OK) heatmap_free(out);
+    return st;
+}
+
+/**
+ * @fn heatmap_save_pgm
+ * @brief Saves a heatmap as a plain (P2) PGM image.
+ * @param h Pointer to the heatmap.
+ * @param path Path to the output file.
+ * @return Status indicating success or failure.
+ */
+Status heatmap_save_pgm(const Heatmap *h, const char *path) {
+    if (!h || !h->count || !path) return STATUS_INVALID;
+
+    // PGM grey levels stop at 65535, larger counts are scaled down
+    uint32_t max = 0;
+    size_t cells = (size_t) h->rows * (size_t) h->cols;
+    for (size_t i = 0; i < cells; ++i) {
+        if (h->count[i] > max) max = h->count[i];
+    }
+    uint32_t maxval = max == 0 ? 1 : (max > 65535 ? 65535 : max);
+
+    FILE *fp = fopen(path, "w");
+    if (!fp) return STATUS_WRITE;
+
+    bool ok = fprintf(fp, "P2\n%d %d\n%u\n", h->cols, h->rows, maxval) >= 0;
+    for (int32_t r = 0; r < h->rows && ok; ++r) {
+        for (int32_t c = 0; c < h->cols && ok; ++c) {
+            uint64_t v = h->count[(size_t) r * (size_t) h->cols + (size_t) c];
+            if (max > maxval) v = v * maxval / max;
+            ok = fprintf(fp, c ? " %u" : "%u", (unsigned) v) >= 0;
+        }
+        if (ok) ok = fputc('\n', fp) != EOF;
+    }
+
+    if (fclose(fp) != 0) ok = false;
+    return ok ? STATUS_OK : STATUS_WRITE;
+}
+
+/**
+ * @fn heatmap_save_csv
+ * @brief Saves the non-zero cells of a heatmap as CSV.
+ * @param h Pointer to the heatmap.
+ * @param path Path to the output file.
+ * @return Status indicating success or failure.
+ */
+Status heatmap_save_csv(const Heatmap *h, const char *path) {
+    if (!h || !h->count || !path) return STATUS_INVALID;
+
+    FILE *fp = fopen(path, "w");
+    if (!fp) return STATUS_WRITE;
+
+    bool ok = fprintf(fp, "row,col,count\n") >= 0;
+    for (int32_t r = 0; r < h->rows && ok; ++r) {
+        for (int32_t c = 0; c < h->cols && ok; ++c) {
+            uint32_t v = h->count[(size_t) r * (size_t) h->cols + (size_t) c];
+            if (v) ok = fprintf(fp, "%d,%d,%u\n", r, c, v) >= 0;
+        }
+    }
+
+    if (fclose(fp) != 0) ok = false;
+    return ok ? STATUS_OK : STATUS_WRITE;
+}
+
+/**
+ * @fn heatmap_free
+ * @brief Frees the resources of a Heatmap.
+ * @param h Pointer to the heatmap.
+ */
+void heatmap_free(Heatmap *h) {
+    if (!h) return;
+    free(h->count);
+    h->count = NULL;
+    h->rows = 0;
+    h->cols = 0;
+}
+
+/**
+ * @fn danger_map_find
+ * @brief Returns the danger grid of one frequency.
+ * @param m Pointer to the map.
+ * @param freq Frequency to look up.
+ * @return Pointer to the grid, or NULL if not found.
+ */
+const BitGrid *danger_map_find(const DangerMap *m, char freq) {
+    if (!m) return NULL;
+    for (size_t t = 0; t < m->count; ++t) {
+        if (m->freq[t] == freq) return &m->grid[t];
+    }
+    return NULL;
+}
+
+/**
+ * @fn danger_map_free
+ * @brief Frees the resources of a DangerMap.
+ * @param m Pointer to the map.
+ */
+void danger_map_free(DangerMap *m) {
+    if (!m) return;
+    for (size_t t = 0; t < m->count; ++t) bitgrid_free(&m->grid[t]);
+    free(m->grid);
+    free(m->freq);
+    bitgrid_free(&m->all);
+    memset(m, 0, sizeof(*m));
+}
+
+/**
+ * @struct IndexJob
+ *
+ * @brief Shared context of the per-frequency tasks of the danger index build.
+ */
+typedef struct {
+    const Graph *g;
+    const FreqBuckets *buckets;
+    const char *freq;    /* frequency of each task              */
+    DangerIndex *ix;
+} IndexJob;
+
+/**
+ * @struct IndexSet
+ *
+ * @brief Frequency set being filled and the graph it belongs to.
+ */
+typedef struct {
+    const Graph *g;
+    CoordSet *set;
+} IndexSet;
+
+/**
+ * @fn index_antinode
+ * @brief Counts an antinode in a frequency set if it lies inside the map.
+ * @param row Row of the antinode.
+ * @param col Column of the antinode.
+ * @param ctx Pointer to the IndexSet.
+ * @return Status indicating success or failure.
+ */
+static Status index_antinode(int64_t row, int64_t col, void *ctx) {
+    IndexSet *ix = ctx;
+    if (row < 0 || row >= ix->g->rows || col < 0 || col >= ix->g->cols) return STATUS_OK;
+    return coord_set_insert(ix->set, (Coord) {.row = (int32_t) row, .col = (int32_t) col}, NULL);
+}
+
+/**
+ * @fn index_task
+ * @brief Task body of the danger index build: one frequency per task.
+ * @param task Index of the frequency in the job.
+ * @param worker Index of the executing worker (unused).
+ * @param ctx Pointer to the IndexJob.
+ * @return Status indicating success or failure.
+ */
+static Status index_task(size_t task, size_t worker, void *ctx) {
+    (void) worker;
+    IndexJob *job = ctx;
+    const Graph *g = job->g;
+    char f = job->freq[task];
+    size_t k = freq_bucket_size(job->buckets, f);
+    CoordSet *set = &job->ix->freq[(unsigned char) f];
+
+    // Two antinodes per pair at most, and never more than the map holds
+    size_t expected = k * (k - 1);
+    size_t cells = (size_t) g->rows * (size_t) g->cols;
+    Status st = coord_set_init(set, expected < cells ? expected : cells);
+    if (st != STATUS_OK) return st;
+
+    Coord *pts = malloc(k * sizeof(Coord));
+    if (!pts) return STATUS_ALLOC;
+    sorted_bucket(g, freq_bucket(job->buckets, f), k, pts);
+
+    IndexSet target = {.g = g, .set = set};
+    for (size_t a = 0; a < k && st == STATUS_OK; ++a) {
+        st = anchor_antinodes(pts, a, k, g->rows, index_antinode, &target);
+    }
+    free(pts);
+    return st;
+}
+
+/**
+ * @fn danger_index_build
+ * @brief Fills an empty danger index from the antennas of the graph.
+ * @param g Pointer to the graph.
+ * @param ix Pointer to the zeroed index.
+ * @return Status indicating success or failure.
+ */
+static Status danger_index_build(const Graph *g, DangerIndex *ix) {
+    FreqBuckets buckets;
+    Status st = graph_freq_buckets(g, &buckets);
+    if (st != STATUS_OK) return st;
+
+    // Schedule the largest buckets first so the pool stays balanced
+    size_t order[FREQ_SLOTS][2];
+    size_t nf = 0;
+    for (size_t f = 0; f < FREQ_SLOTS; ++f) {
+        size_t k = buckets.start[f + 1] - buckets.start[f];
+        if (k >= 2) {
+            order[nf][0] = k;
+            order[nf][1] = f;
+            nf++;
+        }
+    }
+    qsort(order, nf, sizeof(order[0]), bucket_compare_size);
+    char freq[FREQ_SLOTS];
+    for (size_t t = 0; t < nf; ++t) freq[t] = (char) order[t][1];
+
+    IndexJob job = {.g = g, .buckets = &buckets, .freq = freq, .ix = ix};
+    st = parallel_for(nf, 0, index_task, &job);
+    freq_buckets_free(&buckets);
+
+    // Merge the frequency sets into the combined one
+    size_t largest = 0;
+    for (size_t f = 0; f < FREQ_SLOTS; ++f) {
+        if (ix->freq[f].count > largest) largest = ix->freq[f].count;
+    }
+    if (st == STATUS_OK) st = coord_set_init(&ix->all, largest);
+    for (size_t f = 0; f < FREQ_SLOTS && st == STATUS_OK; ++f) {
+        const CoordSet *set = &ix->freq[f];
+        if (set->count == 0) continue;
+        freq_mask_add(&ix->present, (char) f);
+        for (size_t i = 0; i < set->cap && st == STATUS_OK; ++i) {
+            if (set->used[i]) st = coord_set_insert(&ix->all, coord_set_at(set, i), NULL);
+        }
+    }
+    return st;
+}
+
+/**
+ * @fn danger_index_refresh
+ * @brief Builds the danger index of the graph if it is missing or stale.
+ * @param g Pointer to the graph.
+ * @return Status indicating success or failure.
+ */
+static Status danger_index_refresh(Graph *g) {
+    if (g->danger && !g->danger_stale) return STATUS_OK;
+    if (g->danger) {
+        danger_index_free(g->danger);
+    } else {
+        g->danger = calloc(1, sizeof(DangerIndex));
+        if (!g->danger) return STATUS_ALLOC;
+    }
+
+    Status st = danger_index_build(g, g->danger);
+    if (st != STATUS_OK) {
+        danger_index_free(g->danger);
+        free(g->danger);
+        g->danger = NULL;
+        return st;
+    }
+    g->danger_stale = false;
+    return STATUS_OK;
+}
+
+/**
+ * @fn index_hit
+ * @brief Checks a cell against an up-to-date danger index.
+ * @param ix Pointer to the index.
+ * @param c Cell to check.
+ * @param mask Frequencies to check, NULL for all of them.
+ * @return True if the cell is dangerous for one of the frequencies, false otherwise.
+ */
+static bool index_hit(const DangerIndex *ix, Coord c, const FreqMask *mask) {
+    if (!coord_set_contains(&ix->all, c)) return false;
+    if (!mask) return true;
+    for (size_t w = 0; w < FREQ_SLOTS / 64; ++w) {
+        for (uint64_t bits = mask->bits[w] & ix->present.bits[w]; bits; bits &= bits - 1) {
+            if (coord_set_contains(&ix->freq[w * 64 + bitgrid_lowest_bit(bits)], c)) return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @fn graph_is_dangerous
+ * @brief Checks whether a cell is dangerous for any of the given frequencies.
+ * @param g Pointer to the graph.
+ * @param row Row of the cell.
+ * @param col Column of the cell.
+ * @param mask Frequencies to check, NULL for all of them.
+ * @param dangerous Pointer to store the result.
+ * @return Status indicating success or failure.
+ */
+Status graph_is_dangerous(Graph *g, int32_t row, int32_t col, const FreqMask *mask, bool *dangerous) {
+    if (!g || !dangerous) return STATUS_INVALID;
+    Status st = danger_index_refresh(g);
+    if (st != STATUS_OK) return st;
+
+    *dangerous = index_hit(g->danger, (Coord) {.row = row, .col = col}, mask);
+    return STATUS_OK;
+}
+
+/**
+ * @struct QueryJob
+ *
+ * @brief Shared context of the chunks of graph_is_dangerous_batch().
+ */
+typedef struct {
+    const DangerIndex *ix;
+    const Coord *cells;
+    size_t n;
+    const FreqMask *mask;
+    bool *dangerous;
+} QueryJob;
+
+/**
+ * @fn query_task
+ * @brief Answers one chunk of DANGER_QUERY_CHUNK queries.
+ * @param task Chunk number.
+ * @param worker Index of the executing worker (unused).
+ * @param ctx Pointer to the QueryJob.
+ * @return Always STATUS_OK.
+ */
+static Status query_task(size_t task, size_t worker, void *ctx) {
+    (void) worker;
+    QueryJob *job = ctx;
+    size_t lo = task * DANGER_QUERY_CHUNK;
+    size_t hi = job->n - lo < DANGER_QUERY_CHUNK ? job->n : lo + DANGER_QUERY_CHUNK;
+    for (size_t i = lo; i < hi; ++i) job->dangerous[i] = index_hit(job->ix, job->cells[i], job->mask);
+    return STATUS_OK;
+}
+
+/**
+ * @fn graph_is_dangerous_batch
+ * @brief Checks many cells at once for danger from any of the given frequencies.
+ * @param g Pointer to the graph.
+ * @param cells Cells to check.
+ * @param n Number of cells.
+ * @param mask Frequencies to check, NULL for all of them.
+ * @param n_workers Number of worker threads (0 for one per processor).
+ * @param dangerous Output array of n results.
+ * @return Status indicating success or failure.
+ */
+Status graph_is_dangerous_batch(Graph *g, const Coord *cells, size_t n, const FreqMask *mask,
+                                size_t n_workers, bool *dangerous) {
+    if (!g || (n && (!cells || !dangerous))) return STATUS_INVALID;
+    Status st = danger_index_refresh(g);
+    if (st != STATUS_OK) return st;
+
+    QueryJob job = {.ix = g->danger, .cells = cells, .n = n, .mask = mask, .dangerous = dangerous};
+    return parallel_for((n + DANGER_QUERY_CHUNK - 1) / DANGER_QUERY_CHUNK, n_workers, query_task, &job);
+}
+
+/**
+ * @fn graph_danger_index
+ * @brief Returns the danger index of the graph, building it if needed.
+ * @param g Pointer to the graph.
+ * @param out Pointer to store the index.
+ * @return Status indicating success or failure.
+ */
+Status graph_danger_index(Graph *g, const DangerIndex **out) {
+    if (!g || !out) return STATUS_INVALID;
+    Status st = danger_index_refresh(g);
+    *out = st == STATUS_OK ? g->danger : NULL;
+    return st;
+}
+
+/**
+ * @fn index_add_cell
+ * @brief Counts one more pair putting an antinode on an in-map cell.
+ * @param ix Pointer to the index.
+ * @param freq Frequency of the pair.
+ * @param c Cell of the antinode.
+ * @return Status indicating success or failure.
+ */
+static Status index_add_cell(DangerIndex *ix, char freq, Coord c) {
+    CoordSet *set = &ix->freq[(unsigned char) freq];
+    if (!set->keys) {
+        Status st = coord_set_init(set, 0);
+        if (st != STATUS_OK) return st;
+    }
+
+    bool inserted;
+    Status st = coord_set_insert(set, c, &inserted);
+    if (st != STATUS_OK || !inserted) return st;
+    // First pair of this frequency on the cell
+    freq_mask_add(&ix->present, freq);
+    if (!ix->all.keys) {
+        st = coord_set_init(&ix->all, 0);
+        if (st != STATUS_OK) return st;
+    }
+    return coord_set_insert(&ix->all, c, NULL);
+}
+
+/**
+ * @fn index_remove_cell
+ * @brief Counts one pair fewer putting an antinode on an in-map cell.
+ * @param ix Pointer to the index.
+ * @param freq Frequency of the pair.
+ * @param c Cell of the antinode.
+ * @return Status indicating success or failure.
+ */
+static Status index_remove_cell(DangerIndex *ix, char freq, Coord c) {
+    CoordSet *set = &ix->freq[(unsigned char) freq];
+    bool removed;
+    Status st = coord_set_release(set, c, &removed);
+    if (st != STATUS_OK || !removed) return st;
+    // Last pair of this frequency left the cell
+    if (set->count == 0) freq_mask_remove(&ix->present, freq);
+    return coord_set_release(&ix->all, c, NULL);
+}
+
+/**
+ * @fn index_update_antenna
+ * @brief Adds or withdraws the antinodes of every pair formed by one antenna.
+ * @param ix Pointer to the index.
+ * @param g Pointer to the graph.
+ * @param idx Vertex index of the antenna.
+ * @param add True to add the antinodes, false to withdraw them.
+ * @return Status indicating success or failure.
+ */
+static Status index_update_antenna(DangerIndex *ix, const Graph *g, size_t idx, bool add) {
+    const Vertex *a = &g->v[idx];
+    Status st = STATUS_OK;
+    // The adjacency list of the antenna is its frequency clique
+    for (EdgeNode *e = g->adj[idx]; e && st == STATUS_OK; e = e->next) {
+        const Vertex *b = &g->v[e->dest];
+        int64_t dr = (int64_t) b->row - a->row;
+        int64_t dc = (int64_t) b->col - a->col;
+        if (dr == 0 && dc == 0) continue; // skip same point
+
+        int64_t node[2][2] = {{a->row - dr, a->col - dc}, {b->row + dr, b->col + dc}};
+        for (size_t t = 0; t < 2 && st == STATUS_OK; ++t) {
+            int64_t row = node[t][0], col = node[t][1];
+            if (row < 0 || row >= g->rows || col < 0 || col >= g->cols) continue;
+            Coord c = {.row = (int32_t) row, .col = (int32_t) col};
+            st = add ? index_add_cell(ix, a->freq, c) : index_remove_cell(ix, a->freq, c);
+        }
+    }
+    return st;
+}
+
+/**
+ * @fn danger_index_add_antenna
+ * @brief Adds the antinodes that a new antenna forms with its frequency.
+ * @param ix Pointer to the index.
+ * @param g Pointer to the graph.
+ * @param idx Vertex index of the antenna.
+ * @return Status indicating success or failure.
+ */
+Status danger_index_add_antenna(DangerIndex *ix, const Graph *g, size_t idx) {
+    if (!ix || !g || idx >= g->n) return STATUS_INVALID;
+    return index_update_antenna(ix, g, idx, true);
+}
+
+/**
+ * @fn danger_index_remove_antenna
+ * @brief Withdraws the antinodes of an antenna about to be removed.
+ * @param ix Pointer to the index.
+ * @param g Pointer to the graph.
+ * @param idx Vertex index of the antenna.
+ * @return Status indicating success or failure.
+ */
+Status danger_index_remove_antenna(DangerIndex *ix, const Graph *g, size_t idx) {
+    if (!ix || !g || idx >= g->n) return STATUS_INVALID;
+    return index_update_antenna(ix, g, idx, false);
+}
+
+/**
+ * @fn danger_index_free
+ * @brief Frees the resources of a DangerIndex.
+ * @param ix Pointer to the index.
+ */
+void danger_index_free(DangerIndex *ix) {
+    if (!ix) return;
+    coord_set_free(&ix->all);
+    for (size_t f = 0; f < FREQ_SLOTS; ++f) coord_set_free(&ix->freq[f]);
+    memset(ix, 0, sizeof(*ix));
+}
+
+/**
+ * Number of antennas per graph_top_antennas() task.
+ */
+#define TOP_ANTENNA_CHUNK 64
+
+/**
+ * @struct Ranked
+ *
+ * @brief Ranked structure holding one top-k candidate: higher score first, then lower key.
+ */
+typedef struct {
+    uint64_t score;
+    uint64_t key;
+} Ranked;
+
+/**
+ * @fn ranked_before
+ * @brief Checks whether a candidate ranks strictly before another.
+ * @param a Pointer to the first candidate.
+ * @param b Pointer to the second candidate.
+ * @return True if a ranks before b.
+ */
+static inline bool ranked_before(const Ranked *a, const Ranked *b) {
+    return a->score != b->score ? a->score > b->score : a->key < b->key;
+}
+
+/**
+ * @fn by_rank
+ * @brief qsort comparator ordering candidates best first.
+ * @param a Pointer to the first candidate.
+ * @param b Pointer to the second candidate.
+ * @return Comparison result.
+ */
+static int by_rank(const void *a, const void *b) {
+    return ranked_before(a, b) ? -1 : ranked_before(b, a);
+}
+
+/**
+ * @fn top_offer
+ * @brief Offers a candidate to a bounded heap that keeps the best ones, worst at the root.
+ * @param heap Heap entries.
+ * @param size Pointer to the number of entries.
+ * @param cap Heap capacity.
+ * @param r Candidate.
+ */
+static void top_offer(Ranked *heap, size_t *size, size_t cap, Ranked r) {
+    size_t i;
+    if (*size < cap) {
+        for (i = (*size)++; i > 0 && ranked_before(&heap[(i - 1) / 2], &r); i = (i - 1) / 2) {
+            heap[i] = heap[(i - 1) / 2];
+        }
+        heap[i] = r;
+        return;
+    }
+    if (!ranked_before(&r, &heap[0])) return;
+    for (i = 0;;) {
+        size_t c = 2 * i + 1;
+        if (c >= cap) break;
+        if (c + 1 < cap && ranked_before(&heap[c], &heap[c + 1])) c++;
+        if (ranked_before(&heap[c], &r)) break;
+        heap[i] = heap[c];
+        i = c;
+    }
+    heap[i] = r;
+}
+
+/**
+ * @fn top_merge
+ * @brief Packs the worker heaps, sorts the survivors and keeps the best k.
+ * @param heap Worker heaps, cap entries each; the best entries are left at the front.
+ * @param size Entries in each worker heap.
+ * @param workers Number of worker heaps.
+ * @param cap Capacity of each heap.
+ * @return The number of entries kept.
+ */
+static size_t top_merge(Ranked *heap, const size_t *size, size_t workers, size_t cap) {
+    size_t total = 0;
+    for (size_t w = 0; w < workers; ++w) {
+        for (size_t i = 0; i < size[w]; ++i) heap[total++] = heap[w * cap + i];
+    }
+    qsort(heap, total, sizeof(Ranked), by_rank);
+    return total < cap ? total : cap;
+}
+
+/**
+ * @struct TopCellJob
+ *
+ * @brief Shared state of one heatmap_top_cells() call.
+ */
+typedef struct {
+    const Heatmap *h;
+    size_t k;
+    Ranked *heap;        /* k entries per worker                */
+    size_t *size;        /* entries in each worker's heap       */
+} TopCellJob;
+
+/**
+ * @fn top_cell_task
+ * @brief Offers the hit cells of one block of HEATMAP_ROW_BLOCK rows to the worker's heap.
+ * @param task Block number.
+ * @param worker Index of the executing worker.
+ * @param ctx Pointer to the TopCellJob.
+ * @return Always STATUS_OK.
+ */
+static Status top_cell_task(size_t task, size_t worker, void *ctx) {
+    TopCellJob *job = ctx;
+    size_t cols = (size_t) job->h->cols;
+    size_t from = task * HEATMAP_ROW_BLOCK * cols;
+    size_t rows_left = (size_t) job->h->rows - task * HEATMAP_ROW_BLOCK;
+    size_t to = from + (rows_left < HEATMAP_ROW_BLOCK ? rows_left : HEATMAP_ROW_BLOCK) * cols;
+    Ranked *heap = job->heap + worker * job->k;
+    size_t *size = &job->size[worker];
+
+    for (size_t i = from; i < to; ++i) {
+        uint32_t c = job->h->count[i];
+        // A full heap only takes counts at least as high as its root
+        if (c == 0 || (*size == job->k && c < heap[0].score)) continue;
+        top_offer(heap, size, job->k, (Ranked) {.score = c, .key = i});
+    }
+    return STATUS_OK;
+}
+
+/**
+ * @fn heatmap_top_cells
+ * @brief Finds the k cells of a heatmap hit by the most pairs.
+ * @param h Pointer to the heatmap.
+ * @param k Number of cells wanted.
+ * @param n_workers Number of worker threads (0 for one per processor).
+ * @param out Output array of at least k cells.
+ * @param count Pointer to store the number of cells written.
+ * @return Status indicating success or failure.
+ */
+Status heatmap_top_cells(const Heatmap *h, size_t k, size_t n_workers, HotCell *out, size_t *count) {
+    if (!h || !count || (k && !out)) return STATUS_INVALID;
+    *count = 0;
+    size_t cells = (size_t) h->rows * (size_t) h->cols;
+    if (k > cells) k = cells;
+    if (k == 0) return STATUS_OK;
+    if (!h->count) return STATUS_INVALID;
+
+    size_t n_tasks = ((size_t) h->rows + HEATMAP_ROW_BLOCK - 1) / HEATMAP_ROW_BLOCK;
+    n_workers = parallel_worker_count(n_workers, n_tasks);
+    TopCellJob job = {.h = h, .k = k};
+    job.heap = malloc(n_workers * k * sizeof(Ranked));
+    job.size = calloc(n_workers, sizeof(size_t));
+    if (!job.heap || !job.size) {
+        free(job.heap);
+        free(job.size);
+        return STATUS_ALLOC;
+    }
+
+    Status st = parallel_for(n_tasks, n_workers, top_cell_task, &job);
+    if (st == STATUS_OK) {
+        *count = top_merge(job.heap, job.size, n_workers, k);
+        for (size_t i = 0; i < *count; ++i) {
+            size_t cell = (size_t) job.heap[i].key;
+            out[i].cell = (Coord) {.row = (int32_t) (cell / (size_t) h->cols), .col = (int32_t) (cell % (size_t) h->cols)};
+            out[i].count = (uint32_t) job.heap[i].score;
+        }
+    }
+    free(job.heap);
+    free(job.size);
+    return st;
+}
+
+/**
+ * @struct TopAntennaJob
+ *
+ * @brief Shared state of one graph_top_antennas() call.
+ */
+typedef struct {
+    const Graph *g;
+    const FreqBuckets *buckets;
+    const DangerIndex *ix;
+    size_t k;
+    Coord *nodes;        /* antinode scratch per worker         */
+    size_t nodes_cap;    /* scratch entries per worker          */
+    size_t *cleared;     /* cleared cells of each antenna       */
+    size_t *touched;     /* touched cells of each antenna       */
+    Ranked *heap;        /* k entries per worker                */
+    size_t *size;        /* entries in each worker's heap       */
+} TopAntennaJob;
+
+/**
+ * @fn top_antenna_task
+ * @brief Attributes the danger of one chunk of TOP_ANTENNA_CHUNK antennas.
+ * @param task Chunk number.
+ * @param worker Index of the executing worker.
+ * @param ctx Pointer to the TopAntennaJob.
+ * @return Always STATUS_OK.
+ */
+static Status top_antenna_task(size_t task, size_t worker, void *ctx) {
+    TopAntennaJob *job = ctx;
+    const Graph *g = job->g;
+    Coord *nodes = job->nodes + worker * job->nodes_cap;
+    size_t lo = task * TOP_ANTENNA_CHUNK;
+    size_t hi = g->n - lo < TOP_ANTENNA_CHUNK ? g->n : lo + TOP_ANTENNA_CHUNK;
+
+    for (size_t idx = lo; idx < hi; ++idx) {
+        const Vertex *a = &g->v[idx];
+        const size_t *bucket = freq_bucket(job->buckets, a->freq);
+        size_t k = freq_bucket_size(job->buckets, a->freq);
+
+        // The in-map antinodes of the antenna's own pairs, as the index counts them
+        size_t n = 0;
+        for (size_t j = 0; j < k; ++j) {
+            const Vertex *b = &g->v[bucket[j]];
+            int64_t dr = (int64_t) b->row - a->row;
+            int64_t dc = (int64_t) b->col - a->col;
+            if (bucket[j] == idx || (dr == 0 && dc == 0)) continue;
+
+            int64_t node[2][2] = {{a->row - dr, a->col - dc}, {b->row + dr, b->col + dc}};
+            for (size_t t = 0; t < 2; ++t) {
+                int64_t row = node[t][0], col = node[t][1];
+                if (row < 0 || row >= g->rows || col < 0 || col >= g->cols) continue;
+                nodes[n++] = (Coord) {.row = (int32_t) row, .col = (int32_t) col};
+            }
+        }
+        qsort(nodes, n, sizeof(Coord), coord_compare_rows);
+
+        // A cell is cleared when every pair of its frequency on it involves this antenna
+        const CoordSet *set = &job->ix->freq[(unsigned char) a->freq];
+        size_t cleared = 0, touched = 0;
+        for (size_t i = 0, j; i < n; i = j) {
+            for (j = i + 1; j < n && nodes[j].row == nodes[i].row && nodes[j].col == nodes[i].col; ++j) {}
+            touched++;
+            if (coord_set_hits(set, nodes[i]) == j - i && coord_set_hits(&job->ix->all, nodes[i]) == 1) cleared++;
+        }
+        job->cleared[idx] = cleared;
+        job->touched[idx] = touched;
+
+        uint64_t score = ((uint64_t) (cleared < UINT32_MAX ? cleared : UINT32_MAX) << 32) |
+                         (touched < UINT32_MAX ? touched : UINT32_MAX);
+        top_offer(job->heap + worker * job->k, &job->size[worker], job->k, (Ranked) {.score = score, .key = idx});
+    }
+    return STATUS_OK;
+}
+
+/**
+ * @fn graph_top_antennas
+ * @brief Finds the k antennas whose removal would clear the most danger cells.
+ * @param g Pointer to the graph.
+ * @param k Number of antennas wanted.
+ * @param n_workers Number of worker threads (0 for one per processor).
+ * @param out Output array of at least k entries.
+ * @param count Pointer to store the number of entries written.
+ * @return Status indicating success or failure.
+ */
+Status graph_top_antennas(Graph *g, size_t k, size_t n_workers, AntennaImpact *out, size_t *count) {
+    if (!g || !count || (k && !out)) return STATUS_INVALID;
+    *count = 0;
+    if (k > g->n) k = g->n;
+    if (k == 0) return STATUS_OK;
+
+    Status st = danger_index_refresh(g);
+    if (st != STATUS_OK) return st;
+    FreqBuckets buckets;
+    st = graph_freq_buckets(g, &buckets);
+    if (st != STATUS_OK) return st;
+
+    size_t largest = 0;
+    for (size_t f = 0; f < FREQ_SLOTS; ++f) {
+        size_t size = buckets.start[f + 1] - buckets.start[f];
+        if (size > largest) largest = size;
+    }
+
+    size_t n_tasks = (g->n + TOP_ANTENNA_CHUNK - 1) / TOP_ANTENNA_CHUNK;
+    n_workers = parallel_worker_count(n_workers, n_tasks);
+    TopAntennaJob job = {.g = g, .buckets = &buckets, .ix = g->danger, .k = k, .nodes_cap = 2 * largest};
+    job.nodes = malloc(n_workers * job.nodes_cap * sizeof(Coord));
+    job.cleared = malloc(g->n * sizeof(size_t));
+    job.touched = malloc(g->n * sizeof(size_t));
+    job.heap = malloc(n_workers * k * sizeof(Ranked));
+    job.size = calloc(n_workers, sizeof(size_t));
+    if (!job.nodes || !job.cleared || !job.touched || !job.heap || !job.size) {
+        st = STATUS_ALLOC;
+    } else {
+        st = parallel_for(n_tasks, n_workers, top_antenna_task, &job);
+    }
+
+    if (st == STATUS_OK) {
+        *count = top_merge(job.heap, job.size, n_workers, k);
+        for (size_t i = 0; i < *count; ++i) {
+            size_t idx = (size_t) job.heap[i].key;
+            out[i] = (AntennaImpact) {.idx = idx, .cleared = job.cleared[idx], .touched = job.touched[idx]};
+        }
+    }
+    free(job.nodes);
+    free(job.cleared);
+    free(job.touched);
+    free(job.heap);
+    free(job.size);
+    freq_buckets_free(&buckets);
+    return st;
+}
@@ -29,8 +29,8 @@
 #include <string.h>     /* strlen */
 #include <ctype.h>      /* isprint */
 #include "../include/graph.h"
-
-#define MAX_DANGER 1024
+#include "../include/coord_set.h"
+#include "../include/danger.h"
 
 /**
  * ---------------------------------------------------------
@@ -67,6 +67,15 @@ static Status add_vertex(Graph *g, char freq, int row, int col, size_t *out_idx)
  */
 static Status add_edge(Graph *g, size_t src, size_t dst);
 
+/**
+ * @fn uf_union
+ * @brief Merges the union-find sets of two vertices.
+ * @param g Pointer to the graph.
+ * @param a First vertex index.
+ * @param b Second vertex index.
+ */
+static void uf_union(Graph *g, size_t a, size_t b);
+
 /**
  * @fn graph_init
  * @brief Initializes a graph with a given initial capacity.
@@ -84,9 +93,15 @@ Status graph_init(Graph **pg, size_t reserve) {
     g->cap = reserve ? reserve : 4;
     g->v = calloc(g->cap, sizeof(Vertex));
     g->adj = calloc(g->cap, sizeof(EdgeNode *));
-    if (!g->v || !g->adj) {
+    g->uf_parent = malloc(g->cap * sizeof(size_t));
+    g->uf_size = malloc(g->cap * sizeof(size_t));
+    g->uf_rank = malloc(g->cap * sizeof(uint8_t));
+    if (!g->v || !g->adj || !g->uf_parent || !g->uf_size || !g->uf_rank) {
         free(g->v);
         free(g->adj);
+        free(g->uf_parent);
+        free(g->uf_size);
+        free(g->uf_rank);
         free(g);
         return STATUS_ALLOC;
     }
@@ -115,6 +130,11 @@ Status graph_free(Graph **pg) {
     }
     free(g->adj);
     free(g->v);
+    free(g->uf_parent);
+    free(g->uf_size);
+    free(g->uf_rank);
+    danger_index_free(g->danger);
+    free(g->danger);
     free(g);
     *pg = NULL;
     return STATUS_OK;
@@ -139,6 +159,11 @@ Status graph_clear_lists(Graph *g) {
         g->adj[i] = NULL;
     }
     g->n = 0; // Reset vertex count
+    g->rows = 0;
+    g->cols = 0;
+    g->uf_stale = false;
+    // The antennas are gone, so is the danger they caused
+    g->danger_stale = true;
     return STATUS_OK;
 }
 
@@ -153,8 +178,9 @@ Status graph_save_matrix(const Graph *g, const char *path) {
     if (!g || !path)
         return STATUS_INVALID;
 
-    // Determine grid dimensions based on vertices.
-    int max_row = 0, max_col = 0;
+    // Determine grid dimensions based on the map size and the vertices.
+    int max_row = g->rows > 0 ? g->rows - 1 : 0;
+    int max_col = g->cols > 0 ? g->cols - 1 : 0;
     for (size_t i = 0; i < g->n; i++) {
         if (g->v[i].row > max_row)
             max_row = g->v[i].row;
@@ -254,6 +280,11 @@ Status graph_from_matrix_file(Graph **out_g, const char *path) {
     int row = 0;
 
     while ((read = custom_getlines(&line, &len, fp)) != -1) {
+        // Record the map width without the line terminator
+        size_t width = read;
+        while (width > 0 && (line[width - 1] == '\n' || line[width - 1] == '\r')) width--;
+        if (width > (size_t) g->cols) g->cols = (int32_t) width;
+
         for (int col = 0; col < read; ++col) {
             char c = line[col];
             if (is_antenna(c)) {
@@ -264,6 +295,7 @@ Status graph_from_matrix_file(Graph **out_g, const char *path) {
         }
         row++;
     }
+    if (row > g->rows) g->rows = row;
 
     /* Connect equal-frequency antennas with edges (undirected).  */
     for (size_t i = 0; i < g->n; ++i) {
@@ -300,12 +332,20 @@ Status graph_insert_vertex(Graph *g, char freq, int row, int col) {
     if (st != STATUS_OK) return st;
 
     // Connect the new vertex to existing vertices with the same frequency
+    bool linked = true;
     for (size_t i = 0; i < g->n - 1; ++i) {
         if (g->v[i].freq == freq) {
-            add_edge(g, idx, i);
+            if (add_edge(g, idx, i) != STATUS_OK) linked = false;
             add_edge(g, i, idx);
         }
     }
+
+    // Keep a current danger index current: only the new pairs change it.
+    // The index walks the new clique edges, so a missing one forces a rebuild.
+    if (!linked) g->danger_stale = true;
+    if (g->danger && !g->danger_stale && danger_index_add_antenna(g->danger, g, idx) != STATUS_OK) {
+        g->danger_stale = true;
+    }
     return STATUS_OK;
 }
 
@@ -319,6 +359,11 @@ Status graph_insert_vertex(Graph *g, char freq, int row, int col) {
 Status graph_remove_vertex(Graph *g, size_t idx) {
     if (!g || idx >= g->n) return STATUS_INVALID;
 
+    // Withdraw the antinodes of the vertex while its coordinates are known
+    if (g->danger && !g->danger_stale && danger_index_remove_antenna(g->danger, g, idx) != STATUS_OK) {
+        g->danger_stale = true;
+    }
+
     // Free the edges of the vertex to be removed
     EdgeNode *e = g->adj[idx];
     while (e) {
@@ -334,111 +379,454 @@ Status graph_remove_vertex(Graph *g, size_t idx) {
         g->adj[i] = g->adj[i + 1];
     }
     g->n--;
+    g->adj[g->n] = NULL; // the last list moved down, do not let the next insert inherit it
 
+    // Drop the edges into the removed vertex and renumber the ones past it
+    for (size_t i = 0; i < g->n; ++i) {
+        EdgeNode **link = &g->adj[i];
+        while (*link) {
+            EdgeNode *cur = *link;
+            if (cur->dest == idx) {
+                *link = cur->next;
+                free(cur);
+                continue;
+            }
+            if (cur->dest > idx) cur->dest--;
+            link = &cur->next;
+        }
+    }
+
+    // A removal can split a component, which a union-find cannot undo
+    g->uf_stale = true;
     return STATUS_OK;
 }
 
 /**
- * @fn graph_dfs
- * @brief Performs a depth-first search on the graph.
+ * @fn graph_retune_vertex
+ * @brief Changes the frequency of a vertex and moves it to the clique of its new frequency.
+ * @param g Pointer to the graph.
+ * @param idx Index of the vertex.
+ * @param freq New frequency.
+ * @return Status indicating success or failure.
+ */
+Status graph_retune_vertex(Graph *g, size_t idx, char freq) {
+    if (!g || idx >= g->n) return STATUS_INVALID;
+    if (g->v[idx].freq == freq) return STATUS_OK;
+
+    // Withdraw the antinodes of the old frequency while it is still set
+    if (g->danger && !g->danger_stale && danger_index_remove_antenna(g->danger, g, idx) != STATUS_OK) {
+        g->danger_stale = true;
+    }
+
+    // Unlink the vertex from the clique of its old frequency
+    EdgeNode *e = g->adj[idx];
+    while (e) {
+        EdgeNode **link = &g->adj[e->dest];
+        while (*link) {
+            EdgeNode *cur = *link;
+            if (cur->dest == idx) {
+                *link = cur->next;
+                free(cur);
+                continue;
+            }
+            link = &cur->next;
+        }
+        EdgeNode *tmp = e;
+        e = e->next;
+        free(tmp);
+    }
+    g->adj[idx] = NULL;
+
+    // Leaving a clique can split a component, which a union-find cannot undo
+    g->uf_stale = true;
+    g->v[idx].freq = freq;
+    for (size_t i = 0; i < g->n; ++i) {
+        if (i == idx || g->v[i].freq != freq) continue;
+        Status st = add_edge(g, idx, i);
+        if (st == STATUS_OK) st = add_edge(g, i, idx);
+        if (st != STATUS_OK) {
+            // The old antinodes are already withdrawn; let the next query rebuild
+            g->danger_stale = true;
+            return st;
+        }
+    }
+
+    if (g->danger && !g->danger_stale && danger_index_add_antenna(g->danger, g, idx) != STATUS_OK) {
+        g->danger_stale = true;
+    }
+    return STATUS_OK;
+}
+
+/**
+ * @fn graph_freq_buckets
+ * @brief Groups the vertex indices by frequency with a counting sort.
+ * @param g Pointer to the graph.
+ * @param out Pointer to the buckets to fill.
+ * @return Status indicating success or failure.
+ */
+Status graph_freq_buckets(const Graph *g, FreqBuckets *out) {
+    if (!g || !out) return STATUS_INVALID;
+    memset(out->start, 0, sizeof(out->start));
+    out->idx = NULL;
+
+    // Count, then turn the counts into offsets
+    for (size_t i = 0; i < g->n; ++i) out->start[(unsigned char) g->v[i].freq + 1]++;
+    for (size_t f = 0; f < FREQ_SLOTS; ++f) out->start[f + 1] += out->start[f];
+    if (g->n == 0) return STATUS_OK;
+
+    out->idx = malloc(g->n * sizeof(size_t));
+    if (!out->idx) return STATUS_ALLOC;
+
+    size_t fill[FREQ_SLOTS];
+    memcpy(fill, out->start, sizeof(fill));
+    for (size_t i = 0; i < g->n; ++i) out->idx[fill[(unsigned char) g->v[i].freq]++] = i;
+    return STATUS_OK;
+}
+
+/**
+ * @fn freq_buckets_free
+ * @brief Frees the resources of a FreqBuckets structure.
+ * @param b Pointer to the buckets.
+ */
+void freq_buckets_free(FreqBuckets *b) {
+    if (!b) return;
+    free(b->idx);
+    b->idx = NULL;
+    memset(b->start, 0, sizeof(b->start));
+}
+
+/**
+ * @fn traversal_workspace_init
+ * @brief Initializes a traversal workspace for graphs of up to n vertices.
+ * @param ws Pointer to the workspace.
+ * @param n Expected number of vertices.
+ * @return Status indicating success or failure.
+ */
+Status traversal_workspace_init(TraversalWorkspace *ws, size_t n) {
+    if (!ws) return STATUS_INVALID;
+    *ws = (TraversalWorkspace) {0};
+    return traversal_workspace_reserve(ws, n);
+}
+
+/**
+ * @fn traversal_workspace_reserve
+ * @brief Grows a workspace so that it fits a graph of n vertices.
+ * @param ws Pointer to the workspace.
+ * @param n Number of vertices.
+ * @return Status indicating success or failure.
+ */
+Status traversal_workspace_reserve(TraversalWorkspace *ws, size_t n) {
+    if (!ws) return STATUS_INVALID;
+    if (n <= ws->cap) return STATUS_OK;
+
+    uint32_t *mark = realloc(ws->mark, n * sizeof(uint32_t));
+    if (!mark) return STATUS_ALLOC;
+    ws->mark = mark;
+    // Slots past the old capacity were never stamped
+    memset(mark + ws->cap, 0, (n - ws->cap) * sizeof(uint32_t));
+    EdgeNode **next = realloc(ws->next, n * sizeof(EdgeNode *));
+    if (!next) return STATUS_ALLOC;
+    ws->next = next;
+    ws->cap = n;
+
+    if (ws->stack_cap < n) {
+        size_t *stack = realloc(ws->stack, n * sizeof(size_t));
+        if (!stack) return STATUS_ALLOC;
+        ws->stack = stack;
+        ws->stack_cap = n;
+    }
+    return STATUS_OK;
+}
+
+/**
+ * @fn traversal_workspace_free
+ * @brief Frees the resources of a traversal workspace.
+ * @param ws Pointer to the workspace.
+ */
+void traversal_workspace_free(TraversalWorkspace *ws) {
+    if (!ws) return;
+    free(ws->mark);
+    free(ws->stack);
+    free(ws->next);
+    *ws = (TraversalWorkspace) {0};
+}
+
+/**
+ * @fn ws_begin
+ * @brief Starts a traversal: every vertex becomes unvisited in O(1).
+ * @param ws Pointer to the workspace.
+ */
+static inline void ws_begin(TraversalWorkspace *ws) {
+    if (++ws->epoch == 0) {
+        // The stamp wrapped around, forget every previous traversal
+        memset(ws->mark, 0, ws->cap * sizeof(uint32_t));
+        ws->epoch = 1;
+    }
+}
+
+/**
+ * @fn ws_seen
+ * @brief Checks whether a vertex was visited in the current traversal.
+ * @param ws Pointer to the workspace.
+ * @param v Vertex index.
+ * @return True if the vertex is visited, false otherwise.
+ */
+static inline bool ws_seen(const TraversalWorkspace *ws, size_t v) {
+    return ws->mark[v] == ws->epoch;
+}
+
+/**
+ * @fn ws_push
+ * @brief Pushes a vertex on the workspace stack, growing it if needed.
+ * @param ws Pointer to the workspace.
+ * @param top Pointer to the stack height.
+ * @param v Vertex index.
+ * @return Status indicating success or failure.
+ */
+static inline Status ws_push(TraversalWorkspace *ws, size_t *top, size_t v) {
+    if (*top == ws->stack_cap) {
+        size_t cap = ws->stack_cap ? ws->stack_cap * 2 : 16;
+        size_t *stack = realloc(ws->stack, cap * sizeof(size_t));
+        if (!stack) return STATUS_ALLOC;
+        ws->stack = stack;
+        ws->stack_cap = cap;
+    }
+    ws->stack[(*top)++] = v;
+    return STATUS_OK;
+}
+
+/**
+ * @fn graph_dfs_ws
+ * @brief Performs a depth-first search on the graph with a reusable workspace.
  * @param g Pointer to the graph.
  * @param start Starting vertex index.
  * @param fn Function to call for each visited vertex.
  * @param ctx Context pointer to pass to the function.
+ * @param ws Pointer to the workspace.
  * @return Status indicating success or failure.
  */
-Status graph_dfs(const Graph *g, size_t start, VisitFn fn, void *ctx) {
-    if (!g || start >= g->n || !fn) return STATUS_INVALID;
-    Status st;
-
-    bool *vis = calloc(g->n, sizeof(bool));
-    if (!vis) return STATUS_ALLOC;
+Status graph_dfs_ws(const Graph *g, size_t start, VisitFn fn, void *ctx, TraversalWorkspace *ws) {
+    if (!g || start >= g->n || !fn || !ws) return STATUS_INVALID;
+    Status st = traversal_workspace_reserve(ws, g->n);
+    if (st != STATUS_OK) return st;
+    ws_begin(ws);
 
-    // Iterative stack to avoid deep recursion
-    size_t *stack = calloc(g->n, sizeof(size_t));
-    if (!stack) {
-        free(vis);
-        return STATUS_ALLOC;
-    }
+    // Iterative stack to avoid deep recursion; a vertex can be pushed once
+    // per visited neighbour, so the stack grows past n on dense components
     size_t top = 0;
-    stack[top++] = start;
+    ws->stack[top++] = start;
 
     while (top) {
-        size_t v = stack[--top];
-        if (vis[v]) continue;
-        vis[v] = true;
+        size_t v = ws->stack[--top];
+        if (ws_seen(ws, v)) continue;
+        ws->mark[v] = ws->epoch;
 
         st = fn(&g->v[v], ctx);
-        if (st != STATUS_OK) goto done;
+        if (st != STATUS_OK) return st;
 
         for (EdgeNode *e = g->adj[v]; e; e = e->next) {
-            if (!vis[e->dest]) stack[top++] = e->dest;
+            if (ws_seen(ws, e->dest)) continue;
+            st = ws_push(ws, &top, e->dest);
+            if (st != STATUS_OK) return st;
         }
     }
-    st = STATUS_OK;
-
-    done:
-    free(stack);
-    free(vis);
-    return st;
+    return STATUS_OK;
 }
 
 /**
- * @fn graph_bfs
- * @brief Performs a breadth-first search on the graph.
+ * @fn graph_dfs
+ * @brief Performs a depth-first search on the graph.
  * @param g Pointer to the graph.
  * @param start Starting vertex index.
  * @param fn Function to call for each visited vertex.
  * @param ctx Context pointer to pass to the function.
  * @return Status indicating success or failure.
  */
-Status graph_bfs(const Graph *g, size_t start, VisitFn fn, void *ctx) {
+Status graph_dfs(const Graph *g, size_t start, VisitFn fn, void *ctx) {
     if (!g || start >= g->n || !fn) return STATUS_INVALID;
-    Status st;
 
-    bool *vis = calloc(g->n, sizeof(bool));
-    size_t *queue = calloc(g->n, sizeof(size_t));
-    if (!vis || !queue) {
-        free(vis);
-        free(queue);
-        return STATUS_ALLOC;
-    }
+    TraversalWorkspace ws;
+    Status st = traversal_workspace_init(&ws, g->n);
+    if (st == STATUS_OK) st = graph_dfs_ws(g, start, fn, ctx, &ws);
+    traversal_workspace_free(&ws);
+    return st;
+}
 
+/**
+ * @fn graph_bfs_ws
+ * @brief Performs a breadth-first search on the graph with a reusable workspace.
+ * @param g Pointer to the graph.
+ * @param start Starting vertex index.
+ * @param fn Function to call for each visited vertex.
+ * @param ctx Context pointer to pass to the function.
+ * @param ws Pointer to the workspace.
+ * @return Status indicating success or failure.
+ */
+Status graph_bfs_ws(const Graph *g, size_t start, VisitFn fn, void *ctx, TraversalWorkspace *ws) {
+    if (!g || start >= g->n || !fn || !ws) return STATUS_INVALID;
+    Status st = traversal_workspace_reserve(ws, g->n);
+    if (st != STATUS_OK) return st;
+    ws_begin(ws);
+
+    // Vertices are marked when queued, so the queue never holds more than n
+    size_t *queue = ws->stack;
     size_t head = 0, tail = 0;
     queue[tail++] = start;
-    vis[start] = true;
+    ws->mark[start] = ws->epoch;
 
     while (head < tail) {
         size_t v = queue[head++];
         st = fn(&g->v[v], ctx);
-        if (st != STATUS_OK) goto done;
+        if (st != STATUS_OK) return st;
         for (EdgeNode *e = g->adj[v]; e; e = e->next) {
-            if (!vis[e->dest]) {
-                vis[e->dest] = true;
+            if (!ws_seen(ws, e->dest)) {
+                ws->mark[e->dest] = ws->epoch;
                 queue[tail++] = e->dest;
             }
         }
     }
-    st = STATUS_OK;
+    return STATUS_OK;
+}
 
-    done:
-    free(vis);
-    free(queue);
+/**
+ * @fn graph_bfs
+ * @brief Performs a breadth-first search on the graph.
+ * @param g Pointer to the graph.
+ * @param start Starting vertex index.
+ * @param fn Function to call for each visited vertex.
+ * @param ctx Context pointer to pass to the function.
+ * @return Status indicating success or failure.
+ */
+Status graph_bfs(const Graph *g, size_t start, VisitFn fn, void *ctx) {
+    if (!g || start >= g->n || !fn) return STATUS_INVALID;
+
+    TraversalWorkspace ws;
+    Status st = traversal_workspace_init(&ws, g->n);
+    if (st == STATUS_OK) st = graph_bfs_ws(g, start, fn, ctx, &ws);
+    traversal_workspace_free(&ws);
+    return st;
+}
+
+/**
+ * @fn graph_for_each_path_ws
+ * @brief Streams every simple path from src to dst to a callback, with a reusable workspace.
+ * @param g Pointer to the graph.
+ * @param src Source vertex index.
+ * @param dst Destination vertex index.
+ * @param limits Optional limits, NULL for none.
+ * @param fn Callback receiving each path.
+ * @param ctx User context passed to the callback.
+ * @param truncated Optional output, true if the search stopped early.
+ * @param ws Pointer to the workspace.
+ * @return Status indicating success or failure.
+ */
+Status graph_for_each_path_ws(const Graph *g, size_t src, size_t dst, const PathLimits *limits,
+                              PathFn fn, void *ctx, bool *truncated, TraversalWorkspace *ws) {
+    if (!g || src >= g->n || dst >= g->n || !fn || !ws) return STATUS_INVALID;
+    Status st = traversal_workspace_reserve(ws, g->n);
+    if (st != STATUS_OK) return st;
+    ws_begin(ws);
+
+    size_t max_paths = limits ? limits->max_paths : 0;
+    size_t max_depth = limits ? limits->max_depth : 0;
+    uint64_t deadline = limits && limits->max_ms ? now_ms() + limits->max_ms : 0;
+
+    size_t *path = ws->stack;
+    EdgeNode **next = ws->next;    /* next edge to try at each depth */
+    bool cut = false;
+    size_t found = 0, steps = 0, len = 0;
+
+    if (src == dst) {
+        // The single-vertex path, nothing extends past the destination
+        path[0] = src;
+        st = fn(path, 1, ctx);
+    } else {
+        path[len] = src;
+        next[len++] = g->adj[src];
+        ws->mark[src] = ws->epoch;
+    }
+
+    while (len > 0) {
+        if (deadline && ++steps % PATH_CLOCK_STRIDE == 0 && now_ms() >= deadline) {
+            cut = true;
+            break;
+        }
+
+        EdgeNode *e = next[len - 1];
+        while (e && ws_seen(ws, e->dest)) e = e->next;
+        if (e && max_depth && len > max_depth) {
+            // The path already has max_depth edges
+            cut = true;
+            e = NULL;
+        }
+        if (!e) {
+            ws->mark[path[--len]] = 0;
+            continue;
+        }
+
+        next[len - 1] = e->next;
+        path[len++] = e->dest;
+        if (e->dest == dst) {
+            st = fn(path, len--, ctx);
+            if (st != STATUS_OK) break;
+            if (max_paths && ++found >= max_paths) {
+                cut = true;
+                break;
+            }
+            continue;
+        }
+        ws->mark[e->dest] = ws->epoch;
+        next[len - 1] = g->adj[e->dest];
+    }
+
+    if (st == STATUS_STOP) {
+        cut = true;
+        st = STATUS_OK;
+    }
+    if (truncated) *truncated = cut;
+    return st;
+}
+
+/**
+ * @fn graph_for_each_path
+ * @brief Streams every simple path from src to dst to a callback.
+ * @param g Pointer to the graph.
+ * @param src Source vertex index.
+ * @param dst Destination vertex index.
+ * @param limits Optional limits, NULL for none.
+ * @param fn Callback receiving each path.
+ * @param ctx User context passed to the callback.
+ * @param truncated Optional output, true if the search stopped early.
+ * @return Status indicating success or failure.
+ */
+Status graph_for_each_path(const Graph *g, size_t src, size_t dst, const PathLimits *limits,
+                           PathFn fn, void *ctx, bool *truncated) {
+    if (!g || src >= g->n || dst >= g->n || !fn) return STATUS_INVALID;
+
+    TraversalWorkspace ws;
+    Status st = traversal_workspace_init(&ws, g->n);
+    if (st == STATUS_OK) st = graph_for_each_path_ws(g, src, dst, limits, fn, ctx, truncated, &ws);
+    traversal_workspace_free(&ws);
     return st;
 }
 
 /**
  * @fn save_path
- * @brief Saves a path to the output structure.
- * @param out Pointer to the output structure.
+ * @brief Copies a streamed path into a PathSet, growing it geometrically.
  * @param path Pointer to the path array.
  * @param len Length of the path.
+ * @param ctx Pointer to the output PathSet.
  * @return Status indicating success or failure.
  */
-static Status save_path(PathSet *out, size_t *path, size_t len) {
-    Path *new_paths = realloc(out->path, (out->count + 1) * sizeof(Path));
-    if (!new_paths) return STATUS_ALLOC;
-    out->path = new_paths;
+static Status save_path(const size_t *path, size_t len, void *ctx) {
+    PathSet *out = ctx;
+    if (out->count == out->cap) {
+        size_t cap = out->cap ? out->cap * 2 : 8;
+        Path *new_paths = realloc(out->path, cap * sizeof(Path));
+        if (!new_paths) return STATUS_ALLOC;
+        out->path = new_paths;
+        out->cap = cap;
+    }
     out->path[out->count].idx = malloc(len * sizeof(size_t));
     if (!out->path[out->count].idx) return STATUS_ALLOC;
     memcpy(out->path[out->count].idx, path, len * sizeof(size_t));
@@ -448,74 +836,282 @@ static Status save_path(PathSet *out, size_t *path, size_t len) {
 }
 
 /**
- * @fn dfs_all_paths
- * @brief Depth-first search to find all paths from src to dst.
+ * @fn graph_all_paths
+ * @brief Finds all paths from src to dst in the graph.
  * @param g Pointer to the graph.
- * @param current Current vertex index.
+ * @param src Source vertex index.
  * @param dst Destination vertex index.
- * @param visited Array of visited vertices.
- * @param path Array to store the current path.
- * @param path_len Length of the current path.
  * @param out Pointer to the output structure.
  * @return Status indicating success or failure.
  */
-static Status dfs_all_paths(const Graph *g, size_t current, size_t dst,
-                            bool *visited, size_t *path, size_t path_len,
-                            PathSet *out) {
-    visited[current] = true;
-    path[path_len++] = current;
+Status graph_all_paths(const Graph *g, size_t src, size_t dst, PathSet *out) {
+    if (!out) return STATUS_INVALID;
 
-    if (current == dst) {
-        Status st = save_path(out, path, path_len);
-        visited[current] = false;
-        return st;
+    out->path = NULL;
+    out->count = 0;
+    out->cap = 0;
+
+    Status st = graph_for_each_path(g, src, dst, NULL, save_path, out, NULL);
+    if (st != STATUS_OK) path_set_free(out);
+    return st;
+}
+
+/**
+ * @fn graph_all_paths_ws
+ * @brief Finds all paths from src to dst in the graph with a reusable workspace.
+ * @param g Pointer to the graph.
+ * @param src Source vertex index.
+ * @param dst Destination vertex index.
+ * @param out Pointer to the output structure.
+ * @param ws Pointer to the workspace.
+ * @return Status indicating success or failure.
+ */
+Status graph_all_paths_ws(const Graph *g, size_t src, size_t dst, PathSet *out, TraversalWorkspace *ws) {
+    if (!out) return STATUS_INVALID;
+
+    out->path = NULL;
+    out->count = 0;
+    out->cap = 0;
+
+    Status st = graph_for_each_path_ws(g, src, dst, NULL, save_path, out, NULL, ws);
+    if (st != STATUS_OK) path_set_free(out);
+    return st;
+}
+
+/**
+ * @fn path_set_free
+ * @brief Frees the paths of a PathSet.
+ * @param ps Pointer to the PathSet.
+ */
+void path_set_free(PathSet *ps) {
+    if (!ps) return;
+    for (size_t i = 0; i < ps->count; ++i) free(ps->path[i].idx);
+    free(ps->path);
+    ps->path = NULL;
+    ps->count = 0;
+    ps->cap = 0;
+}
+
+/**
+ * @fn sat_add
+ * @brief Saturating 64-bit addition.
+ * @param a First operand.
+ * @param b Second operand.
+ * @param sat Set to true if the result saturated.
+ * @return min(a + b, UINT64_MAX).
+ */
+static inline uint64_t sat_add(uint64_t a, uint64_t b, bool *sat) {
+    if (a > UINT64_MAX - b) {
+        *sat = true;
+        return UINT64_MAX;
     }
+    return a + b;
+}
 
-    for (EdgeNode *e = g->adj[current]; e; e = e->next) {
-        if (!visited[e->dest]) {
-            Status st = dfs_all_paths(g, e->dest, dst, visited, path, path_len, out);
-            if (st != STATUS_OK) return st;
+/**
+ * @fn sat_mul
+ * @brief Saturating 64-bit multiplication.
+ * @param a First operand.
+ * @param b Second operand.
+ * @param sat Set to true if the result saturated.
+ * @return min(a * b, UINT64_MAX).
+ */
+static inline uint64_t sat_mul(uint64_t a, uint64_t b, bool *sat) {
+    if (a != 0 && b > UINT64_MAX / a) {
+        *sat = true;
+        return UINT64_MAX;
+    }
+    return a * b;
+}
+
+/**
+ * @fn component_of
+ * @brief Collects the component of a vertex and tells whether it is complete.
+ * @param g Pointer to the graph.
+ * @param start Vertex of the component.
+ * @param comp Output array (g->n entries) of component vertices, start first.
+ * @param slot Output array (g->n entries): position in comp, or SIZE_MAX outside the component.
+ * @param size Pointer to store the component size.
+ * @param complete Pointer to store whether every pair of the component is adjacent.
+ */
+static void component_of(const Graph *g, size_t start, size_t *comp, size_t *slot, size_t *size, bool *complete) {
+    for (size_t i = 0; i < g->n; ++i) slot[i] = SIZE_MAX;
+
+    size_t head = 0, tail = 0;
+    comp[tail] = start;
+    slot[start] = tail++;
+    while (head < tail) {
+        size_t v = comp[head++];
+        for (EdgeNode *e = g->adj[v]; e; e = e->next) {
+            if (slot[e->dest] == SIZE_MAX) {
+                comp[tail] = e->dest;
+                slot[e->dest] = tail++;
+            }
+        }
+    }
+    *size = tail;
+
+    // Complete iff every vertex sees all the others (duplicate edges and loops ignored)
+    *complete = true;
+    bool *seen = calloc(tail, sizeof(bool));
+    if (!seen) {
+        *complete = false;
+        return;
+    }
+    for (size_t i = 0; i < tail && *complete; ++i) {
+        size_t distinct = 0;
+        for (EdgeNode *e = g->adj[comp[i]]; e; e = e->next) {
+            size_t j = slot[e->dest];
+            if (j != i && !seen[j]) {
+                seen[j] = true;
+                distinct++;
+            }
         }
+        for (EdgeNode *e = g->adj[comp[i]]; e; e = e->next) seen[slot[e->dest]] = false;
+        if (distinct != tail - 1) *complete = false;
+    }
+    free(seen);
+}
+
+/**
+ * @fn count_paths_dp
+ * @brief Counts the simple paths from comp[0] to comp[dst] with a DP over visited subsets.
+ * @details ways[mask][v] is the number of simple paths from comp[0] that visit exactly
+ * the vertices of mask (comp[0] excluded) and end at v. Paths are not extended past dst.
+ * @param g Pointer to the graph.
+ * @param comp Component vertices (source first).
+ * @param slot Position of each graph vertex in comp.
+ * @param c Component size (at most PATH_COUNT_DP_MAX).
+ * @param dst Position of the destination in comp.
+ * @param count Pointer to store the count.
+ * @param sat Set to true if the count saturated.
+ * @return Status indicating success or failure.
+ */
+static Status count_paths_dp(const Graph *g, const size_t *comp, const size_t *slot, size_t c,
+                             size_t dst, uint64_t *count, bool *sat) {
+    size_t masks = (size_t) 1 << (c - 1);
+    uint64_t *ways = calloc(masks * c, sizeof(uint64_t));
+    if (!ways) return STATUS_ALLOC;
+
+    // Bit j - 1 of a mask stands for comp[j]; the source is implicit
+    for (EdgeNode *e = g->adj[comp[0]]; e; e = e->next) {
+        size_t j = slot[e->dest];
+        if (j != 0) ways[((size_t) 1 << (j - 1)) * c + j] = 1;
     }
 
-    visited[current] = false;
+    uint64_t total = 0;
+    for (size_t mask = 1; mask < masks; ++mask) {
+        for (size_t v = 1; v < c; ++v) {
+            uint64_t w = ways[mask * c + v];
+            if (w == 0) continue;
+            if (v == dst) {
+                total = sat_add(total, w, sat);
+                continue;
+            }
+            for (EdgeNode *e = g->adj[comp[v]]; e; e = e->next) {
+                size_t j = slot[e->dest];
+                if (j == 0 || (mask >> (j - 1)) & 1) continue;
+                size_t next = mask | ((size_t) 1 << (j - 1));
+                ways[next * c + j] = sat_add(ways[next * c + j], w, sat);
+            }
+        }
+    }
+
+    free(ways);
+    *count = total;
     return STATUS_OK;
 }
 
 /**
- * @fn graph_all_paths
- * @brief Finds all paths from src to dst in the graph.
+ * @fn graph_count_paths
+ * @brief Counts the simple paths from src to dst without enumerating them.
  * @param g Pointer to the graph.
  * @param src Source vertex index.
  * @param dst Destination vertex index.
- * @param out Pointer to the output structure.
+ * @param count Pointer to store the number of paths.
+ * @param saturated Optional output, true if the count saturated.
  * @return Status indicating success or failure.
  */
-Status graph_all_paths(const Graph *g, size_t src, size_t dst, PathSet *out) {
-    if (!g || src >= g->n || dst >= g->n || !out) return STATUS_INVALID;
-
-    out->path = NULL;
-    out->count = 0;
+Status graph_count_paths(const Graph *g, size_t src, size_t dst, uint64_t *count, bool *saturated) {
+    if (!g || src >= g->n || dst >= g->n || !count) return STATUS_INVALID;
+    bool sat = false;
+    *count = 0;
+    if (saturated) *saturated = false;
 
-    bool *visited = calloc(g->n, sizeof(bool));
-    if (!visited) return STATUS_ALLOC;
+    // A path from a vertex to itself is the single-vertex path, as in graph_all_paths()
+    if (src == dst) {
+        *count = 1;
+        return STATUS_OK;
+    }
 
-    size_t *path = malloc(g->n * sizeof(size_t));
-    if (!path) {
-        free(visited);
+    size_t *comp = malloc(g->n * sizeof(size_t));
+    size_t *slot = malloc(g->n * sizeof(size_t));
+    if (!comp || !slot) {
+        free(comp);
+        free(slot);
         return STATUS_ALLOC;
     }
 
-    Status st = dfs_all_paths(g, src, dst, visited, path, 0, out);
-    free(visited);
-    free(path);
+    size_t c;
+    bool complete;
+    component_of(g, src, comp, slot, &c, &complete);
+
+    Status st = STATUS_OK;
+    if (slot[dst] == SIZE_MAX) {
+        *count = 0;
+    } else if (complete) {
+        // Ordered choices of j intermediate vertices out of the other c - 2
+        uint64_t m = c - 2, term = 1, total = 1;
+        for (uint64_t j = 1; j <= m; ++j) {
+            term = sat_mul(term, m - j + 1, &sat);
+            total = sat_add(total, term, &sat);
+        }
+        *count = total;
+    } else if (c <= PATH_COUNT_DP_MAX) {
+        st = count_paths_dp(g, comp, slot, c, slot[dst], count, &sat);
+    } else {
+        st = STATUS_UNSUPPORTED;
+    }
 
+    free(comp);
+    free(slot);
+    if (saturated) *saturated = sat;
     return st;
 }
 
+/**
+ * @fn freq_coords
+ * @brief Collects the coordinates of all vertices with the given frequency.
+ * @param g Pointer to the graph.
+ * @param freq Frequency to collect.
+ * @param out_pts Pointer to store the allocated coordinate array (NULL if empty).
+ * @param out_k Pointer to store the number of collected vertices.
+ * @return Status indicating success or failure.
+ */
+static Status freq_coords(const Graph *g, char freq, Coord **out_pts, size_t *out_k) {
+    *out_pts = NULL;
+    *out_k = 0;
+
+    size_t k = 0;
+    for (size_t i = 0; i < g->n; ++i) {
+        if (g->v[i].freq == freq) k++;
+    }
+    if (k == 0) return STATUS_OK;
+
+    Coord *pts = malloc(k * sizeof(Coord));
+    if (!pts) return STATUS_ALLOC;
+    k = 0;
+    for (size_t i = 0; i < g->n; ++i) {
+        if (g->v[i].freq == freq) pts[k++] = (Coord) {.row = g->v[i].row, .col = g->v[i].col};
+    }
+    *out_pts = pts;
+    *out_k = k;
+    return STATUS_OK;
+}
+
 /**
  * @fn graph_intersections
- * @brief Finds intersections of two frequencies in the graph.
+ * @brief Finds intersections of two frequencies in the graph with a hash join.
  * @param g Pointer to the graph.
  * @param freqA Frequency A.
  * @param freqB Frequency B.
@@ -524,37 +1120,156 @@ Status graph_all_paths(const Graph *g, size_t src, size_t dst, PathSet *out) {
  */
 Status graph_intersections(const Graph *g, char freqA, char freqB, CoordList *out) {
     if (!g || !out) return STATUS_INVALID;
+    coord_list_init(out);
+
+    Coord *ptsA, *ptsB;
+    size_t kA, kB;
+    Status st = freq_coords(g, freqA, &ptsA, &kA);
+    if (st != STATUS_OK) return st;
+    st = freq_coords(g, freqB, &ptsB, &kB);
+    if (st != STATUS_OK || kA == 0 || kB == 0) {
+        free(ptsA);
+        free(ptsB);
+        return st;
+    }
+
+    // Build on the smaller bucket, probe with the larger one
+    const Coord *build = kA <= kB ? ptsA : ptsB;
+    const Coord *probe = kA <= kB ? ptsB : ptsA;
+    size_t n_build = kA <= kB ? kA : kB;
+    size_t n_probe = kA <= kB ? kB : kA;
 
-    out->coord = NULL;
+    CoordSet cells;
+    st = coord_set_init(&cells, n_build);
+    for (size_t i = 0; i < n_build && st == STATUS_OK; ++i) {
+        st = coord_set_insert(&cells, build[i], NULL);
+    }
+    for (size_t i = 0; i < n_probe && st == STATUS_OK; ++i) {
+        // One intersection per co-located antenna of the build side
+        uint32_t hits = coord_set_hits(&cells, probe[i]);
+        for (uint32_t h = 0; h < hits && st == STATUS_OK; ++h) {
+            st = coord_list_push(out, probe[i]);
+        }
+    }
+
+    coord_set_free(&cells);
+    free(ptsA);
+    free(ptsB);
+    if (st != STATUS_OK) coord_list_free(out);
+    return st;
+}
+
+/**
+ * @struct CellVertex
+ *
+ * @brief A vertex index together with its cell, used to group co-located vertices.
+ */
+typedef struct {
+    Coord c;
+    size_t idx;
+} CellVertex;
+
+/**
+ * @fn by_cell
+ * @brief qsort comparator ordering CellVertex entries by cell, then index.
+ * @param a Pointer to the first entry.
+ * @param b Pointer to the second entry.
+ * @return Comparison result.
+ */
+static int by_cell(const void *a, const void *b) {
+    const CellVertex *x = a, *y = b;
+    if (x->c.row != y->c.row) return (x->c.row > y->c.row) - (x->c.row < y->c.row);
+    if (x->c.col != y->c.col) return (x->c.col > y->c.col) - (x->c.col < y->c.col);
+    return (x->idx > y->idx) - (x->idx < y->idx);
+}
+
+/**
+ * @fn pair_list_push
+ * @brief Appends a pair to the list, doubling its capacity when full.
+ * @param list Pointer to the list.
+ * @param p Pair to append.
+ * @return Status indicating success or failure.
+ */
+static Status pair_list_push(PairList *list, VertexPair p) {
+    if (list->count == list->cap) {
+        if (list->cap > SIZE_MAX / 2 / sizeof(VertexPair)) return STATUS_OVERFLOW;
+        size_t new_cap = list->cap ? list->cap * 2 : 16;
+        VertexPair *np = realloc(list->pair, new_cap * sizeof(VertexPair));
+        if (!np) return STATUS_ALLOC;
+        list->pair = np;
+        list->cap = new_cap;
+    }
+    list->pair[list->count++] = p;
+    return STATUS_OK;
+}
+
+/**
+ * @fn pair_list_free
+ * @brief Frees a pair list and resets it to empty.
+ * @param list Pointer to the list.
+ */
+void pair_list_free(PairList *list) {
+    if (!list) return;
+    free(list->pair);
+    list->pair = NULL;
+    list->count = 0;
+    list->cap = 0;
+}
+
+/**
+ * @fn graph_colocated_pairs
+ * @brief Finds every pair of co-located antennas with different frequencies.
+ * @param g Pointer to the graph.
+ * @param out Pointer to the output list.
+ * @return Status indicating success or failure.
+ */
+Status graph_colocated_pairs(const Graph *g, PairList *out) {
+    if (!g || !out) return STATUS_INVALID;
+    out->pair = NULL;
     out->count = 0;
+    out->cap = 0;
 
-    // Allocate memory for storing intersections
-    size_t capacity = 16;
-    out->coord = malloc(capacity * sizeof(Coord));
-    if (!out->coord) return STATUS_ALLOC;
+    CoordSet cells;
+    Status st = coord_set_init(&cells, g->n);
+    for (size_t i = 0; i < g->n && st == STATUS_OK; ++i) {
+        st = coord_set_insert(&cells, (Coord) {.row = g->v[i].row, .col = g->v[i].col}, NULL);
+    }
+    if (st != STATUS_OK) {
+        coord_set_free(&cells);
+        return st;
+    }
 
-    for (size_t i = 0; i < g->n; ++i) {
-        if (g->v[i].freq == freqA) {
-            for (size_t j = 0; j < g->n; ++j) {
-                if (g->v[j].freq == freqB && g->v[i].row == g->v[j].row && g->v[i].col == g->v[j].col) {
-                    // Resize if necessary
-                    if (out->count == capacity) {
-                        capacity *= 2;
-                        Coord *new_coord = realloc(out->coord, capacity * sizeof(Coord));
-                        if (!new_coord) {
-                            free(out->coord);
-                            return STATUS_ALLOC;
-                        }
-                        out->coord = new_coord;
-                    }
-                    // Add intersection
-                    out->coord[out->count++] = (Coord) {.row = g->v[i].row, .col = g->v[i].col};
+    // Only vertices sharing their cell need grouping
+    size_t n_shared = 0;
+    CellVertex *shared = NULL;
+    if (cells.count < g->n) {
+        shared = malloc((g->n - cells.count) * 2 * sizeof(CellVertex));
+        if (!shared) st = STATUS_ALLOC;
+    }
+    for (size_t i = 0; i < g->n && shared && st == STATUS_OK; ++i) {
+        Coord c = {.row = g->v[i].row, .col = g->v[i].col};
+        if (coord_set_hits(&cells, c) > 1) shared[n_shared++] = (CellVertex) {.c = c, .idx = i};
+    }
+    coord_set_free(&cells);
+    if (n_shared) qsort(shared, n_shared, sizeof(CellVertex), by_cell);
+
+    for (size_t from = 0; from < n_shared && st == STATUS_OK;) {
+        size_t to = from + 1;
+        while (to < n_shared && shared[to].c.row == shared[from].c.row && shared[to].c.col == shared[from].c.col) to++;
+
+        for (size_t x = from; x < to && st == STATUS_OK; ++x) {
+            for (size_t y = x + 1; y < to && st == STATUS_OK; ++y) {
+                if (g->v[shared[x].idx].freq != g->v[shared[y].idx].freq) {
+                    st = pair_list_push(out, (VertexPair) {.a = shared[x].idx, .b = shared[y].idx});
                 }
             }
         }
+        from = to;
     }
 
-    return STATUS_OK;
+    free(shared);
+    if (st != STATUS_OK) pair_list_free(out);
+    return st;
 }
 
 /**
@@ -571,21 +1286,6 @@ static void add_unique_coord(Coord *arr, size_t *count, Coord c) {
     arr[(*count)++] = c;
 }
 
-/**
- * @fn coord_in_set
- * @brief Checks if a coordinate is in the set.
- * @param arr Array of coordinates.
- * @param count Count of coordinates.
- * @param c Coordinate to check.
- * @return True if the coordinate is in the set, false otherwise.
- */
-static bool coord_in_set(const Coord *arr, size_t count, Coord c) {
-    for (size_t i = 0; i < count; ++i) {
-        if (arr[i].row == c.row && arr[i].col == c.col) return true;
-    }
-    return false;
-}
-
 /**
  * @fn compute_danger_points
  * @brief Computes danger points based on the graph and frequency.
@@ -593,6 +1293,7 @@ static bool coord_in_set(const Coord *arr, size_t count, Coord c) {
  * @param freq Frequency to check.
  * @param danger Array to store danger points.
  * @param count Pointer to the count of danger points.
+ * @deprecated Use graph_danger_points(), which grows its output as needed.
  */
 Status compute_danger_points(const Graph *g, char freq, Coord *danger, size_t *count) {
     *count = 0;
@@ -614,6 +1315,107 @@ Status compute_danger_points(const Graph *g, char freq, Coord *danger, size_t *c
     return STATUS_OK;
 }
 
+/**
+ * @fn coord_compare_rows
+ * @brief qsort comparator ordering coordinates by row, then column.
+ * @param a Pointer to the first coordinate.
+ * @param b Pointer to the second coordinate.
+ * @return Comparison result.
+ */
+int coord_compare_rows(const void *a, const void *b) {
+    const Coord *x = a, *y = b;
+    if (x->row != y->row) return (x->row > y->row) - (x->row < y->row);
+    return (x->col > y->col) - (x->col < y->col);
+}
+
+/**
+ * @fn danger_bucket
+ * @brief Collects the coordinates of all vertices with the given frequency, sorted by row.
+ * @param g Pointer to the graph.
+ * @param freq Frequency to collect.
+ * @param out_pts Pointer to store the allocated coordinate array (NULL if empty).
+ * @param out_k Pointer to store the number of collected vertices.
+ * @return Status indicating success or failure.
+ */
+static Status danger_bucket(const Graph *g, char freq, Coord **out_pts, size_t *out_k) {
+    Status st = freq_coords(g, freq, out_pts, out_k);
+    if (st == STATUS_OK && *out_k > 1) qsort(*out_pts, *out_k, sizeof(Coord), coord_compare_rows);
+    return st;
+}
+
+/**
+ * @struct DangerPush
+ *
+ * @brief Output of graph_danger_points() while its antinodes are collected.
+ */
+typedef struct {
+    const Graph *g;      /* map size                            */
+    CoordSet *seen;      /* points already emitted              */
+    CoordList *out;      /* output list                         */
+} DangerPush;
+
+/**
+ * @fn push_danger
+ * @brief Appends a danger point to the list unless it lies outside the map
+ * or is already in the set.
+ * @param row Row of the point (64-bit to detect overflow).
+ * @param col Column of the point (64-bit to detect overflow).
+ * @param ctx Pointer to the DangerPush.
+ * @return Status indicating success or failure.
+ */
+static Status push_danger(int64_t row, int64_t col, void *ctx) {
+    DangerPush *p = ctx;
+    if (row < 0 || row >= p->g->rows || col < 0 || col >= p->g->cols) return STATUS_OK;
+
+    Coord c = {.row = (int32_t) row, .col = (int32_t) col};
+    bool inserted;
+    Status st = coord_set_insert(p->seen, c, &inserted);
+    if (st != STATUS_OK || !inserted) return st;
+    return coord_list_push(p->out, c);
+}
+
+/**
+ * @fn graph_danger_points
+ * @brief Computes the in-map danger points of a frequency into a growable list.
+ * @param g Pointer to the graph.
+ * @param freq Frequency to check.
+ * @param out Pointer to the output list.
+ * @return Status indicating success or failure.
+ */
+Status graph_danger_points(const Graph *g, char freq, CoordList *out) {
+    if (!g || !out) return STATUS_INVALID;
+    coord_list_init(out);
+
+    Coord *pts;
+    size_t k;
+    Status st = danger_bucket(g, freq, &pts, &k);
+    if (st != STATUS_OK || k < 2) {
+        free(pts);
+        return st;
+    }
+
+    // Each pair yields at most two points, and never more than the map holds
+    size_t expected = (k <= SIZE_MAX / (k - 1)) ? k * (k - 1) : SIZE_MAX / 2;
+    size_t cells = (size_t) g->rows * (size_t) g->cols;
+    if (expected > cells) expected = cells;
+    CoordSet seen;
+    st = coord_set_init(&seen, expected);
+    if (st != STATUS_OK) {
+        free(pts);
+        return st;
+    }
+
+    DangerPush push = {.g = g, .seen = &seen, .out = out};
+    for (size_t a = 0; a < k && st == STATUS_OK; ++a) {
+        st = anchor_antinodes(pts, a, k, g->rows, push_danger, &push);
+    }
+
+    coord_set_free(&seen);
+    free(pts);
+    if (st != STATUS_OK) coord_list_free(out);
+    return st;
+}
+
 /**
  * @fn graph_danger_overlaps
  * @brief Finds overlapping danger points between two frequencies.
@@ -625,28 +1427,79 @@ Status compute_danger_points(const Graph *g, char freq, Coord *danger, size_t *c
  */
 Status graph_danger_overlaps(const Graph *g, char freqA, char freqB, CoordList *out) {
     if (!g || !out) return STATUS_INVALID;
+    coord_list_init(out);
 
-    Coord dangerA[MAX_DANGER], dangerB[MAX_DANGER];
-    size_t countA, countB;
-    compute_danger_points(g, freqA, dangerA, &countA);
-    compute_danger_points(g, freqB, dangerB, &countB);
-
-    // Allocate for the worst case
-    size_t capacity = countA < countB ? countA : countB;
-    if (capacity == 0) capacity = 1;
-    out->coord = malloc(capacity * sizeof(Coord));
-    if (!out->coord) return STATUS_ALLOC;
-    out->count = 0;
+    CoordList dangerA, dangerB;
+    Status st = graph_danger_points(g, freqA, &dangerA);
+    if (st != STATUS_OK) return st;
+    st = graph_danger_points(g, freqB, &dangerB);
+    if (st != STATUS_OK) {
+        coord_list_free(&dangerA);
+        return st;
+    }
 
-    // Find intersection
-    for (size_t i = 0; i < countA; ++i) {
-        if (coord_in_set(dangerB, countB, dangerA[i])) {
-            out->coord[out->count++] = dangerA[i];
+    // Hash the points of B, then probe with A (keeps the order of A)
+    CoordSet setB;
+    st = coord_set_init(&setB, dangerB.count);
+    for (size_t i = 0; i < dangerB.count && st == STATUS_OK; ++i) {
+        st = coord_set_insert(&setB, dangerB.coord[i], NULL);
+    }
+    for (size_t i = 0; i < dangerA.count && st == STATUS_OK; ++i) {
+        if (coord_set_contains(&setB, dangerA.coord[i])) {
+            st = coord_list_push(out, dangerA.coord[i]);
         }
     }
+
+    coord_set_free(&setB);
+    coord_list_free(&dangerA);
+    coord_list_free(&dangerB);
+    if (st != STATUS_OK) coord_list_free(out);
+    return st;
+}
+
+/**
+ * @fn coord_list_init
+ * @brief Initializes an empty coordinate list.
+ * @param list Pointer to the list.
+ */
+void coord_list_init(CoordList *list) {
+    if (!list) return;
+    list->coord = NULL;
+    list->count = 0;
+    list->cap = 0;
+}
+
+/**
+ * @fn coord_list_push
+ * @brief Appends a coordinate to the list, doubling its capacity when full.
+ * @param list Pointer to the list.
+ * @param c Coordinate to append.
+ * @return Status indicating success or failure.
+ */
+Status coord_list_push(CoordList *list, Coord c) {
+    if (!list) return STATUS_INVALID;
+    if (list->count == list->cap) {
+        if (list->cap > SIZE_MAX / 2 / sizeof(Coord)) return STATUS_OVERFLOW;
+        size_t new_cap = list->cap ? list->cap * 2 : 16;
+        Coord *nc = realloc(list->coord, new_cap * sizeof(Coord));
+        if (!nc) return STATUS_ALLOC;
+        list->coord = nc;
+        list->cap = new_cap;
+    }
+    list->coord[list->count++] = c;
     return STATUS_OK;
 }
 
+/**
+ * @fn coord_list_free
+ * @brief Frees a coordinate list and resets it to empty.
+ * @param list Pointer to the list.
+ */
+void coord_list_free(CoordList *list) {
+    if (!list) return;
+    free(list->coord);
+    coord_list_init(list);
+}
 
 /**
  * @fn graph_vertex_count
@@ -676,15 +1529,26 @@ const Vertex *graph_vertex_at(const Graph *g, size_t idx) {
 static Status ensure_capacity(Graph *g) {
     if (g->n < g->cap) return STATUS_OK;
     size_t new_cap = g->cap * 2;
+
+    // Keep each grown array as soon as it is reallocated, so a later failure leaks nothing
     Vertex *nv = realloc(g->v, new_cap * sizeof(Vertex));
+    if (!nv) return STATUS_ALLOC;
+    g->v = nv;
     EdgeNode **na = realloc(g->adj, new_cap * sizeof(EdgeNode *));
-    if (!nv || !na) return STATUS_ALLOC;
-
+    if (!na) return STATUS_ALLOC;
+    g->adj = na;
     /* zero new adj slots */
     memset(na + g->cap, 0, (new_cap - g->cap) * sizeof(EdgeNode *));
+    size_t *np = realloc(g->uf_parent, new_cap * sizeof(size_t));
+    if (!np) return STATUS_ALLOC;
+    g->uf_parent = np;
+    size_t *ns = realloc(g->uf_size, new_cap * sizeof(size_t));
+    if (!ns) return STATUS_ALLOC;
+    g->uf_size = ns;
+    uint8_t *nr = realloc(g->uf_rank, new_cap * sizeof(uint8_t));
+    if (!nr) return STATUS_ALLOC;
+    g->uf_rank = nr;
 
-    g->v = nv;
-    g->adj = na;
     g->cap = new_cap;
     return STATUS_OK;
 }
@@ -705,6 +1569,15 @@ static Status add_vertex(Graph *g, char freq, int row, int col, size_t *out_idx)
 
     size_t idx = g->n++;
     g->v[idx] = (Vertex) {.freq = freq, .row = row, .col = col};
+    g->uf_parent[idx] = idx;
+    g->uf_size[idx] = 1;
+    g->uf_rank[idx] = 0;
+
+    // Grow the map so that it contains the new vertex; old pairs can then
+    // put antinodes on the new cells, so the danger index is rebuilt
+    if ((row >= g->rows && row < INT32_MAX) || (col >= g->cols && col < INT32_MAX)) g->danger_stale = true;
+    if (row >= g->rows && row < INT32_MAX) g->rows = row + 1;
+    if (col >= g->cols && col < INT32_MAX) g->cols = col + 1;
     if (out_idx) *out_idx = idx;
     return STATUS_OK;
 }
@@ -723,5 +1596,125 @@ static Status add_edge(Graph *g, size_t src, size_t dst) {
     node->dest = dst;
     node->next = g->adj[src];
     g->adj[src] = node;
+    if (!g->uf_stale) uf_union(g, src, dst);
+    return STATUS_OK;
+}
+
+/**
+ * @fn uf_find
+ * @brief Returns the root of a vertex's set, compressing the path to it.
+ * @param g Pointer to the graph.
+ * @param v Vertex index.
+ * @return The root vertex index.
+ */
+static size_t uf_find(Graph *g, size_t v) {
+    size_t root = v;
+    while (g->uf_parent[root] != root) root = g->uf_parent[root];
+    while (g->uf_parent[v] != root) {
+        size_t next = g->uf_parent[v];
+        g->uf_parent[v] = root;
+        v = next;
+    }
+    return root;
+}
+
+/**
+ * @fn uf_union
+ * @brief Merges the union-find sets of two vertices, by rank.
+ * @param g Pointer to the graph.
+ * @param a First vertex index.
+ * @param b Second vertex index.
+ */
+static void uf_union(Graph *g, size_t a, size_t b) {
+    a = uf_find(g, a);
+    b = uf_find(g, b);
+    if (a == b) return;
+    if (g->uf_rank[a] < g->uf_rank[b]) {
+        size_t t = a;
+        a = b;
+        b = t;
+    }
+    g->uf_parent[b] = a;
+    g->uf_size[a] += g->uf_size[b];
+    if (g->uf_rank[a] == g->uf_rank[b]) g->uf_rank[a]++;
+}
+
+/**
+ * @fn uf_refresh
+ * @brief Rebuilds the union-find sets from the adjacency lists if a removal made them stale.
+ * @param g Pointer to the graph.
+ */
+static void uf_refresh(Graph *g) {
+    if (!g->uf_stale) return;
+    for (size_t i = 0; i < g->n; ++i) {
+        g->uf_parent[i] = i;
+        g->uf_size[i] = 1;
+        g->uf_rank[i] = 0;
+    }
+    for (size_t i = 0; i < g->n; ++i) {
+        for (EdgeNode *e = g->adj[i]; e; e = e->next) uf_union(g, i, e->dest);
+    }
+    g->uf_stale = false;
+}
+
+/**
+ * @fn graph_component_of
+ * @brief Returns the component id (representative vertex) of a vertex.
+ * @param g Pointer to the graph.
+ * @param v Vertex index.
+ * @param comp Pointer to store the component id.
+ * @return Status indicating success or failure.
+ */
+Status graph_component_of(Graph *g, size_t v, size_t *comp) {
+    if (!g || v >= g->n || !comp) return STATUS_INVALID;
+    uf_refresh(g);
+    *comp = uf_find(g, v);
+    return STATUS_OK;
+}
+
+/**
+ * @fn graph_component_size
+ * @brief Returns the number of vertices in the component of a vertex.
+ * @param g Pointer to the graph.
+ * @param v Vertex index.
+ * @param size Pointer to store the size.
+ * @return Status indicating success or failure.
+ */
+Status graph_component_size(Graph *g, size_t v, size_t *size) {
+    if (!g || v >= g->n || !size) return STATUS_INVALID;
+    uf_refresh(g);
+    *size = g->uf_size[uf_find(g, v)];
+    return STATUS_OK;
+}
+
+/**
+ * @fn graph_component_count
+ * @brief Returns the number of connected components.
+ * @param g Pointer to the graph.
+ * @param count Pointer to store the count.
+ * @return Status indicating success or failure.
+ */
+Status graph_component_count(Graph *g, size_t *count) {
+    if (!g || !count) return STATUS_INVALID;
+    uf_refresh(g);
+    size_t c = 0;
+    for (size_t i = 0; i < g->n; ++i) c += g->uf_parent[i] == i;
+    *count = c;
+    return STATUS_OK;
+}
+
+/**
+ * @fn graph_reachable
+ * @brief Checks whether two vertices are in the same component.
+ * @param g Pointer to the graph.
+ * @param a First vertex index.
+ * @param b Second vertex index.
+ * @param reachable Pointer to store the result.
+ * @return Status indicating success or failure.
+ */
+Status graph_reachable(Graph *g, size_t a, size_t b, bool *reachable) {
+    if (!g || a >= g->n || b >= g->n || !reachable) return STATUS_INVALID;
+    uf_refresh(g);
+    *reachable = uf_find(g, a) == uf_find(g, b);
     return STATUS_OK;
 }
\ No newline at end of file
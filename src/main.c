@@ -17,6 +17,9 @@
 #include "../include/io_ops.h"
 #include "../include/ui.h"
 
+/* Paths are only listed when there are at most this many of them */
+#define PATHS_PRINT_LIMIT 1000
+
 /**
  * @fn main
  *
@@ -42,6 +45,37 @@ int main() {
     }
 }*/
 
+/**
+ * @struct PrintedPaths
+ *
+ * @brief Context of print_path(): the graph and the paths printed so far.
+ */
+typedef struct {
+    const Graph *g;
+    size_t count;
+} PrintedPaths;
+
+/**
+ * @fn print_path
+ *
+ * @brief Prints one path streamed by graph_for_each_path().
+ *
+ * @return STATUS_OK to keep receiving paths
+ */
+static Status print_path(const size_t *path, size_t len, void *ctx) {
+    PrintedPaths *printed = ctx;
+    printf("\n%zu. %s\n", ++printed->count, TR(STR_INFO_PATH));
+    for (size_t s = 0; s < len; ++s) {
+        const Vertex *v = graph_vertex_at(printed->g, path[s]);
+        printf("%s %zu | %s %c | %s (%d,%d)\n",
+               TR(STR_INFO_INDEX), path[s],
+               TR(STR_INFO_FREQUENCY), v->freq,
+               TR(STR_INFO_COORDINATES), v->col, v->row);
+    }
+    puts("");
+    return STATUS_OK;
+}
+
 /**
  * @fn main
  *
@@ -68,7 +102,6 @@ int main(void) {
         char path[128] = INPUT_PATH;
         size_t idx1, idx2 = 0;
         char freqA, freqB;
-        PathSet paths;
         CoordList inters;
 
         switch (choice) {
@@ -120,25 +153,26 @@ int main(void) {
                     break;
                 }
 
-                if (graph_all_paths(g, idx1, idx2, &paths) != STATUS_OK) {
-                    puts(TR(STR_ERR_NOT_IMPLEMENTED));
-                    break;
+                // Count first, enumerating every path is factorial on a large clique
+                uint64_t n_paths;
+                bool saturated;
+                Status counted = graph_count_paths(g, idx1, idx2, &n_paths, &saturated);
+                if (counted == STATUS_OK) {
+                    printf("\n%s: %llu%s\n", TR(STR_INFO_PATH_COUNT),
+                           (unsigned long long) n_paths, saturated ? "+" : "");
+                    if (saturated || n_paths > PATHS_PRINT_LIMIT) {
+                        puts(TR(STR_ERR_TOO_MANY_PATHS));
+                        break;
+                    }
                 }
 
+                // Stream the paths straight to the screen instead of collecting them
+                PrintedPaths printed = {.g = g, .count = 0};
+                PathLimits limits = {.max_paths = PATHS_PRINT_LIMIT};
                 printf("\n%s:", TR(STR_INFO_PATHS_FOUND));
-                // Print paths
-                for (size_t p = 0; p < paths.count; ++p) {
-                    printf("\n%zu. %s\n", p + 1, TR(STR_INFO_PATH));
-                    for (size_t s = 0; s < paths.path[p].len; ++s) {
-                        const Vertex *v = graph_vertex_at(g, paths.path[p].idx[s]);
-                        printf("%s %zu | %s %c | %s (%d,%d)\n",
-                               TR(STR_INFO_INDEX), paths.path[p].idx[s],
-                               TR(STR_INFO_FREQUENCY), v->freq,
-                               TR(STR_INFO_COORDINATES), v->col, v->row);
-                    }
-                    puts("");
+                if (graph_for_each_path(g, idx1, idx2, &limits, print_path, &printed, NULL) != STATUS_OK) {
+                    puts(TR(STR_ERR_NOT_IMPLEMENTED));
                 }
-                // TODO free PathSet helper
                 break;
 
             case 5: // Intersections
@@ -148,8 +182,7 @@ int main(void) {
                 }
 
                 // Initialize CoordList
-                inters.coord = NULL;
-                inters.count = 0;
+                coord_list_init(&inters);
 
                 printf("\n%s", TR(STR_INFO_FREQUENCY_A));
                 freqA = getchar();
@@ -178,8 +211,7 @@ int main(void) {
 
             endIntersections:
                 // Free CoordList resources
-                free(inters.coord);
-                inters.coord = NULL;
+                coord_list_free(&inters);
                 break;
             case 6: // Danger overlaps
                 if (!g) {
@@ -212,8 +244,7 @@ int main(void) {
 
 
             endOverlaps:
-                free(inters.coord);
-                inters.coord = NULL;
+                coord_list_free(&inters);
                 break;
             case 7: // Insert
                 if (!g) {
@@ -291,17 +322,18 @@ int main(void) {
                 frequenceA = (char) ch;
                 while (getchar() != '\n'); // clear buffer
 
-                Coord danger[2048];
-                size_t count = 0;
-                Status st = compute_danger_points(g, frequenceA, danger, &count);
-                if (st != STATUS_OK)
+                CoordList danger;
+                if (graph_danger_points(g, frequenceA, &danger) != STATUS_OK) {
                     puts(TR(STR_ERR_NOT_IMPLEMENTED));
+                    break;
+                }
 
                 printf("\n%s %c:\n", TR(STR_INFO_DANGER_POINTS), frequenceA);
-                for (size_t i = 0; i < count; ++i) {
-                    printf("(%d, %d)\n", danger[i].row, danger[i].col);
+                for (size_t i = 0; i < danger.count; ++i) {
+                    printf("(%d, %d)\n", danger.coord[i].row, danger.coord[i].col);
                 }
-                if (count == 0) puts("None.");
+                if (danger.count == 0) puts("None.");
+                coord_list_free(&danger);
                 break;
             case 12: // Clear lists
                 if (!g) {
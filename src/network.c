@@ -0,0 +1,604 @@
+/**
+ * @file network.c
+ * @brief Implementation of the analysis of single-frequency antenna networks.
+ *
+ * The minimum spanning tree is grown with dense Prim: every antenna outside
+ * the tree keeps its distance to the nearest tree antenna, and each step adds
+ * the closest one. The antennas of the network are copied into a contiguous
+ * array first, so every step is a linear sweep over memory.
+ *
+ * Collinear sets are found from anchors: the antennas after the anchor are
+ * grouped by their reduced direction from it, so each group is the part of
+ * one line through the anchor that follows it.
+ *
+ * @author Ahmet Abdullah GULTEKIN
+ * @date 2025-05-25
+ *
+ * @see network.h for the header file containing the function prototypes
+ * and data structures.
+ */
+
+#include <stdlib.h>     /* malloc, calloc, realloc, qsort, free */
+#include <string.h>     /* memcpy */
+#include <math.h>       /* INFINITY */
+#include "../include/network.h"
+#include "../include/parallel.h"
+
+/**
+ * @struct Nearest
+ *
+ * @brief Candidate antenna reported by one worker in one Prim step.
+ */
+typedef struct {
+    double dist;         /* distance to the tree                */
+    size_t idx;          /* local index, SIZE_MAX for none      */
+} Nearest;
+
+/**
+ * @struct PrimJob
+ *
+ * @brief Shared state of one graph_freq_mst() call.
+ */
+typedef struct {
+    Vertex *pts;         /* the k antennas of the network       */
+    size_t *vertex;      /* graph index of each antenna         */
+    size_t k;
+    Metric metric;
+    double *best;        /* distance of each antenna to the tree */
+    size_t *from;        /* tree antenna at that distance       */
+    bool *in_tree;
+    Nearest *slot;       /* 2 x workers candidates, by step parity */
+    SpanningTree *out;
+} PrimJob;
+
+/**
+ * @fn closer
+ * @brief Orders two candidates by distance, then by index.
+ * @param a First candidate.
+ * @param b Second candidate.
+ * @return True if a should be preferred over b.
+ */
+static inline bool closer(Nearest a, Nearest b) {
+    if (b.idx == SIZE_MAX) return a.idx != SIZE_MAX;
+    if (a.idx == SIZE_MAX) return false;
+    return a.dist < b.dist || (a.dist == b.dist && a.idx < b.idx);
+}
+
+/**
+ * @fn prim_sweep
+ * @brief Adds u to the tree and relaxes the antennas of [lo, hi) against it.
+ * @param job Pointer to the job.
+ * @param u Antenna added in the previous step.
+ * @param lo First antenna of the range.
+ * @param hi One past the last antenna of the range.
+ * @return The nearest antenna of the range that is still outside the tree.
+ */
+static Nearest prim_sweep(PrimJob *job, size_t u, size_t lo, size_t hi) {
+    Nearest near = {.dist = INFINITY, .idx = SIZE_MAX};
+    if (u >= lo && u < hi) job->in_tree[u] = true;
+    for (size_t v = lo; v < hi; ++v) {
+        if (job->in_tree[v]) continue;
+        double d = metric_dist(&job->pts[u], &job->pts[v], job->metric);
+        if (d < job->best[v]) {
+            job->best[v] = d;
+            job->from[v] = u;
+        }
+        Nearest cand = {.dist = job->best[v], .idx = v};
+        if (closer(cand, near)) near = cand;
+    }
+    return near;
+}
+
+/**
+ * @fn add_edge_to
+ * @brief Records the tree edge that brings antenna v into the tree.
+ * @param job Pointer to the job.
+ * @param v Antenna joining the tree.
+ */
+static inline void add_edge_to(PrimJob *job, size_t v) {
+    SpanningTree *t = job->out;
+    t->edge[t->count++] = (VertexPair) {.a = job->vertex[job->from[v]], .b = job->vertex[v]};
+    t->length += job->best[v];
+}
+
+/**
+ * @fn prim_team
+ * @brief Runs Prim's algorithm as one worker of a team.
+ * @param team Team of the call.
+ * @param worker Worker index.
+ * @param n_workers Team size.
+ * @param ctx Pointer to the PrimJob.
+ * @return Always STATUS_OK.
+ */
+static Status prim_team(Team *team, size_t worker, size_t n_workers, void *ctx) {
+    PrimJob *job = ctx;
+    size_t lo = job->k * worker / n_workers;
+    size_t hi = job->k * (worker + 1) / n_workers;
+
+    size_t u = 0;
+    for (size_t step = 1; step < job->k; ++step) {
+        // Slots alternate between steps, so a worker one step ahead never
+        // overwrites candidates that a slower worker is still reducing
+        Nearest *slot = job->slot + (step & 1) * n_workers;
+        slot[worker] = prim_sweep(job, u, lo, hi);
+        team_barrier(team);
+
+        Nearest near = slot[0];
+        for (size_t w = 1; w < n_workers; ++w) if (closer(slot[w], near)) near = slot[w];
+        u = near.idx;
+        if (worker == 0) add_edge_to(job, u);
+    }
+    return STATUS_OK;
+}
+
+/**
+ * @fn graph_freq_mst
+ * @brief Computes the minimum spanning tree of the antennas of one frequency.
+ * @param g Pointer to the graph.
+ * @param freq Frequency of the network.
+ * @param metric Length of an edge.
+ * @param n_workers Number of worker threads (0 for one per processor).
+ * @param out Pointer to the output tree.
+ * @return Status indicating success or failure.
+ */
+Status graph_freq_mst(const Graph *g, char freq, Metric metric, size_t n_workers, SpanningTree *out) {
+    if (!g || !out) return STATUS_INVALID;
+    if (metric != METRIC_EUCLIDEAN && metric != METRIC_MANHATTAN) return STATUS_INVALID;
+    out->edge = NULL;
+    out->count = 0;
+    out->length = 0.0;
+
+    size_t k = 0;
+    for (size_t i = 0; i < g->n; ++i) k += g->v[i].freq == freq;
+    if (k == 0) return STATUS_NOT_FOUND;
+
+    if (n_workers == 0) n_workers = parallel_default_workers();
+    if (k < MST_PARALLEL_MIN) n_workers = 1;
+
+    PrimJob job = {.k = k, .metric = metric, .out = out};
+    job.pts = malloc(k * sizeof(Vertex));
+    job.vertex = malloc(k * sizeof(size_t));
+    job.best = malloc(k * sizeof(double));
+    job.from = malloc(k * sizeof(size_t));
+    job.in_tree = calloc(k, sizeof(bool));
+    job.slot = malloc(2 * n_workers * sizeof(Nearest));
+    out->edge = malloc((k > 1 ? k - 1 : 1) * sizeof(VertexPair));
+    Status st = STATUS_OK;
+    if (!job.pts || !job.vertex || !job.best || !job.from || !job.in_tree || !job.slot || !out->edge) {
+        st = STATUS_ALLOC;
+        goto done;
+    }
+
+    for (size_t i = 0, j = 0; i < g->n; ++i) {
+        if (g->v[i].freq != freq) continue;
+        job.pts[j] = g->v[i];
+        job.vertex[j] = i;
+        job.best[j] = INFINITY;
+        job.from[j++] = 0;
+    }
+
+    if (n_workers == 1) {
+        for (size_t step = 1, u = 0; step < k; ++step) {
+            u = prim_sweep(&job, u, 0, k).idx;
+            add_edge_to(&job, u);
+        }
+    } else {
+        st = parallel_team(n_workers, prim_team, &job);
+    }
+
+    done:
+    free(job.pts);
+    free(job.vertex);
+    free(job.best);
+    free(job.from);
+    free(job.in_tree);
+    free(job.slot);
+    if (st != STATUS_OK) spanning_tree_free(out);
+    return st;
+}
+
+/**
+ * @fn spanning_tree_free
+ * @brief Frees the resources of a SpanningTree.
+ * @param t Pointer to the tree.
+ */
+void spanning_tree_free(SpanningTree *t) {
+    if (!t) return;
+    free(t->edge);
+    t->edge = NULL;
+    t->count = 0;
+    t->length = 0.0;
+}
+
+/**
+ * @struct DirSlot
+ *
+ * @brief One direction from the current anchor, with the antennas seen along it.
+ */
+typedef struct {
+    int64_t dr;          /* reduced row step                    */
+    int64_t dc;          /* reduced column step                 */
+    size_t stamp;        /* anchor the slot belongs to, plus one */
+    size_t head;         /* last antenna added, linked by next  */
+    size_t count;        /* antennas in the direction           */
+} DirSlot;
+
+/**
+ * @struct LineSlot
+ *
+ * @brief One reported line, keyed by direction and intercept.
+ */
+typedef struct {
+    int64_t dr;
+    int64_t dc;
+    uint64_t icpt;       /* dc * row - dr * col, modulo 2^64    */
+    const Vertex *on;    /* an antenna of the line, NULL if free */
+} LineSlot;
+
+/**
+ * @struct LineTable
+ *
+ * @brief Open-addressing hash set of the lines reported for one frequency.
+ */
+typedef struct {
+    LineSlot *slot;
+    size_t cap;          /* power of two                        */
+    size_t count;
+} LineTable;
+
+/**
+ * @struct Found
+ *
+ * @brief One collinear set found by a task.
+ */
+typedef struct {
+    size_t first;        /* offset of its members in the part   */
+    size_t count;
+} Found;
+
+/**
+ * @struct CollinearPart
+ *
+ * @brief Collinear sets found for one frequency.
+ */
+typedef struct {
+    Found *found;
+    size_t n_found, cap_found;
+    size_t *members;
+    size_t n_members, cap_members;
+} CollinearPart;
+
+/**
+ * @struct CollinearJob
+ *
+ * @brief Shared state of one graph_collinear() call.
+ */
+typedef struct {
+    const Graph *g;
+    const FreqBuckets *buckets;
+    size_t min_points;
+    const char *freq;    /* frequency of each task              */
+    CollinearPart *part; /* result of each task                 */
+} CollinearJob;
+
+/**
+ * @fn reduce_dir
+ * @brief Computes the reduced direction from a to b, with a positive leading step.
+ * @param a First antenna.
+ * @param b Second antenna.
+ * @param dr Output, reduced row step.
+ * @param dc Output, reduced column step.
+ * @return False if the antennas share a cell, true otherwise.
+ */
+static inline bool reduce_dir(const Vertex *a, const Vertex *b, int64_t *dr, int64_t *dc) {
+    int64_t r = (int64_t) b->row - a->row;
+    int64_t c = (int64_t) b->col - a->col;
+    if (r == 0 && c == 0) return false;
+    int64_t d = gcd64(r < 0 ? -r : r, c < 0 ? -c : c);
+    r /= d;
+    c /= d;
+    // A line has two directions; keep the one pointing down, or right
+    if (r < 0 || (r == 0 && c < 0)) {
+        r = -r;
+        c = -c;
+    }
+    *dr = r;
+    *dc = c;
+    return true;
+}
+
+/**
+ * @fn dir_hash
+ * @brief Hashes a reduced direction.
+ * @param dr Reduced row step.
+ * @param dc Reduced column step.
+ * @return The hash value.
+ */
+static inline uint64_t dir_hash(int64_t dr, int64_t dc) {
+    return mix64((uint64_t) dr * 0x9e3779b97f4a7c15ULL ^ (uint64_t) dc);
+}
+
+/**
+ * @fn same_line
+ * @brief Checks whether antenna b lies on the line through a with direction (dr, dc).
+ * @param a Antenna of the line.
+ * @param b Antenna to test.
+ * @param dr Reduced row step of the line.
+ * @param dc Reduced column step of the line.
+ * @return True if b is on the line, false otherwise.
+ */
+static inline bool same_line(const Vertex *a, const Vertex *b, int64_t dr, int64_t dc) {
+    int64_t r, c;
+    return !reduce_dir(a, b, &r, &c) || (r == dr && c == dc);
+}
+
+/**
+ * @fn line_insert
+ * @brief Adds the line through an antenna with a given direction, unless it is already there.
+ * @details The intercept is computed modulo 2^64, so two lines with the same
+ * key are told apart by testing the stored antenna against the new line.
+ * @param t Pointer to the table.
+ * @param dr Reduced row step of the line.
+ * @param dc Reduced column step of the line.
+ * @param on Antenna of the line.
+ * @param fresh Output, true if the line was not in the table.
+ * @return Status indicating success or failure.
+ */
+static Status line_insert(LineTable *t, int64_t dr, int64_t dc, const Vertex *on, bool *fresh) {
+    if (2 * (t->count + 1) > t->cap) {
+        size_t cap = t->cap ? t->cap * 2 : 16;
+        LineSlot *slot = calloc(cap, sizeof(LineSlot));
+        if (!slot) return STATUS_ALLOC;
+        for (size_t i = 0; i < t->cap; ++i) {
+            if (!t->slot[i].on) continue;
+            size_t j = (size_t) mix64(dir_hash(t->slot[i].dr, t->slot[i].dc) ^ t->slot[i].icpt) & (cap - 1);
+            while (slot[j].on) j = (j + 1) & (cap - 1);
+            slot[j] = t->slot[i];
+        }
+        free(t->slot);
+        t->slot = slot;
+        t->cap = cap;
+    }
+
+    uint64_t icpt = (uint64_t) dc * (uint64_t) (int64_t) on->row - (uint64_t) dr * (uint64_t) (int64_t) on->col;
+    size_t mask = t->cap - 1;
+    size_t i = (size_t) mix64(dir_hash(dr, dc) ^ icpt) & mask;
+    for (; t->slot[i].on; i = (i + 1) & mask) {
+        LineSlot *l = &t->slot[i];
+        if (l->dr == dr && l->dc == dc && l->icpt == icpt && same_line(l->on, on, dr, dc)) {
+            *fresh = false;
+            return STATUS_OK;
+        }
+    }
+    t->slot[i] = (LineSlot) {.dr = dr, .dc = dc, .icpt = icpt, .on = on};
+    t->count++;
+    *fresh = true;
+    return STATUS_OK;
+}
+
+/**
+ * @fn by_index
+ * @brief Orders vertex indices increasingly.
+ * @param a Pointer to the first index.
+ * @param b Pointer to the second index.
+ * @return Negative, zero or positive as for qsort.
+ */
+static int by_index(const void *a, const void *b) {
+    size_t x = *(const size_t *) a, y = *(const size_t *) b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @fn part_add
+ * @brief Records the line made of an anchor and the antennas of one of its directions.
+ * @param part Pointer to the part of the frequency.
+ * @param idx Vertex indices of the frequency bucket.
+ * @param anchor Local index of the anchor.
+ * @param stacked Slot listing the antennas in the cell of the anchor.
+ * @param d Direction slot holding the other antennas.
+ * @param next Links between the antennas of a slot.
+ * @return Status indicating success or failure.
+ */
+static Status part_add(CollinearPart *part, const size_t *idx, size_t anchor, const DirSlot *stacked,
+                       const DirSlot *d, const size_t *next) {
+    size_t count = 1 + stacked->count + d->count;
+    if (part->n_found == part->cap_found) {
+        size_t cap = part->cap_found ? part->cap_found * 2 : 8;
+        Found *found = realloc(part->found, cap * sizeof(Found));
+        if (!found) return STATUS_ALLOC;
+        part->found = found;
+        part->cap_found = cap;
+    }
+    if (part->cap_members - part->n_members < count) {
+        size_t cap = part->cap_members ? part->cap_members : 32;
+        while (cap - part->n_members < count) cap *= 2;
+        size_t *members = realloc(part->members, cap * sizeof(size_t));
+        if (!members) return STATUS_ALLOC;
+        part->members = members;
+        part->cap_members = cap;
+    }
+
+    // The slot lists run from the last antenna back, so fill them from the end
+    size_t *m = part->members + part->n_members;
+    m[0] = idx[anchor];
+    size_t pos = count;
+    for (size_t b = d->head; b != SIZE_MAX; b = next[b]) m[--pos] = idx[b];
+    if (stacked->count) {
+        for (size_t b = stacked->head; b != SIZE_MAX; b = next[b]) m[--pos] = idx[b];
+        qsort(m, count, sizeof(size_t), by_index);
+    }
+
+    part->found[part->n_found++] = (Found) {.first = part->n_members, .count = count};
+    part->n_members += count;
+    return STATUS_OK;
+}
+
+/**
+ * @fn collinear_task
+ * @brief Finds the collinear sets of one frequency.
+ * @param task Index of the frequency in the job.
+ * @param worker Worker index (unused).
+ * @param ctx Pointer to the CollinearJob.
+ * @return Status indicating success or failure.
+ */
+static Status collinear_task(size_t task, size_t worker, void *ctx) {
+    (void) worker;
+    CollinearJob *job = ctx;
+    const Vertex *v = job->g->v;
+    const size_t *idx = freq_bucket(job->buckets, job->freq[task]);
+    size_t k = freq_bucket_size(job->buckets, job->freq[task]);
+    CollinearPart *part = &job->part[task];
+
+    size_t cap = 16;
+    while (cap < 2 * k) cap *= 2;
+    size_t mask = cap - 1;
+    DirSlot *dir = calloc(cap, sizeof(DirSlot));
+    size_t *next = malloc(k * sizeof(size_t));
+    size_t *used = malloc(k * sizeof(size_t));
+    LineTable lines = {0};
+    Status st = STATUS_OK;
+    if (!dir || !next || !used) {
+        st = STATUS_ALLOC;
+        goto done;
+    }
+
+    // A line is reported from its first antenna, so the last anchors cannot start one
+    for (size_t a = 0; a + job->min_points <= k && st == STATUS_OK; ++a) {
+        const Vertex *pa = &v[idx[a]];
+        size_t stamp = a + 1, n_used = 0;
+        DirSlot stacked = {.head = SIZE_MAX};
+        for (size_t b = a + 1; b < k; ++b) {
+            int64_t dr, dc;
+            if (!reduce_dir(pa, &v[idx[b]], &dr, &dc)) {
+                // Antennas in the same cell lie on every line through the anchor
+                next[b] = stacked.head;
+                stacked.head = b;
+                stacked.count++;
+                continue;
+            }
+            size_t i = (size_t) dir_hash(dr, dc) & mask;
+            while (dir[i].stamp == stamp && (dir[i].dr != dr || dir[i].dc != dc)) i = (i + 1) & mask;
+            if (dir[i].stamp != stamp) {
+                dir[i] = (DirSlot) {.dr = dr, .dc = dc, .stamp = stamp, .head = SIZE_MAX, .count = 0};
+                used[n_used++] = i;
+            }
+            next[b] = dir[i].head;
+            dir[i].head = b;
+            dir[i].count++;
+        }
+
+        for (size_t u = 0; u < n_used && st == STATUS_OK; ++u) {
+            const DirSlot *d = &dir[used[u]];
+            if (1 + stacked.count + d->count < job->min_points) continue;
+            // Later antennas of a reported line only see a part of it
+            bool fresh;
+            st = line_insert(&lines, d->dr, d->dc, pa, &fresh);
+            if (st == STATUS_OK && fresh) st = part_add(part, idx, a, &stacked, d, next);
+        }
+    }
+
+    done:
+    free(dir);
+    free(next);
+    free(used);
+    free(lines.slot);
+    return st;
+}
+
+/**
+ * @fn graph_collinear
+ * @brief Finds every line holding at least min_points antennas of the same frequency.
+ * @param g Pointer to the graph.
+ * @param min_points Fewest antennas per line.
+ * @param n_workers Number of worker threads (0 for one per processor).
+ * @param out Pointer to the output sets.
+ * @return Status indicating success or failure.
+ */
+Status graph_collinear(const Graph *g, size_t min_points, size_t n_workers, CollinearSets *out) {
+    if (!g || !out || min_points < COLLINEAR_MIN) return STATUS_INVALID;
+    out->set = NULL;
+    out->count = 0;
+    out->members = NULL;
+
+    FreqBuckets buckets;
+    Status st = graph_freq_buckets(g, &buckets);
+    if (st != STATUS_OK) return st;
+
+    // Schedule the largest frequencies first so the pool stays balanced
+    size_t order[FREQ_SLOTS][2];
+    size_t nf = 0;
+    for (size_t f = 0; f < FREQ_SLOTS; ++f) {
+        size_t k = buckets.start[f + 1] - buckets.start[f];
+        if (k >= min_points) {
+            order[nf][0] = k;
+            order[nf][1] = f;
+            nf++;
+        }
+    }
+    qsort(order, nf, sizeof(order[0]), bucket_compare_size);
+
+    char freq[FREQ_SLOTS];
+    size_t task_of[FREQ_SLOTS];
+    for (size_t f = 0; f < FREQ_SLOTS; ++f) task_of[f] = SIZE_MAX;
+    for (size_t t = 0; t < nf; ++t) {
+        freq[t] = (char) order[t][1];
+        task_of[order[t][1]] = t;
+    }
+
+    CollinearPart *part = calloc(nf ? nf : 1, sizeof(CollinearPart));
+    if (!part) {
+        freq_buckets_free(&buckets);
+        return STATUS_ALLOC;
+    }
+    CollinearJob job = {.g = g, .buckets = &buckets, .min_points = min_points, .freq = freq, .part = part};
+    st = parallel_for(nf, n_workers, collinear_task, &job);
+
+    size_t n_sets = 0, n_members = 0;
+    for (size_t t = 0; t < nf; ++t) {
+        n_sets += part[t].n_found;
+        n_members += part[t].n_members;
+    }
+    if (st == STATUS_OK && n_sets) {
+        out->set = malloc(n_sets * sizeof(CollinearSet));
+        out->members = malloc(n_members * sizeof(size_t));
+        if (!out->set || !out->members) st = STATUS_ALLOC;
+    }
+
+    // Concatenate the parts in frequency order
+    for (size_t f = 0, base = 0; f < FREQ_SLOTS && st == STATUS_OK && n_sets; ++f) {
+        if (task_of[f] == SIZE_MAX) continue;
+        const CollinearPart *p = &part[task_of[f]];
+        if (p->n_members) memcpy(out->members + base, p->members, p->n_members * sizeof(size_t));
+        for (size_t i = 0; i < p->n_found; ++i) {
+            out->set[out->count++] = (CollinearSet) {
+                    .freq = (char) f,
+                    .count = p->found[i].count,
+                    .idx = out->members + base + p->found[i].first
+            };
+        }
+        base += p->n_members;
+    }
+
+    for (size_t t = 0; t < nf; ++t) {
+        free(part[t].found);
+        free(part[t].members);
+    }
+    free(part);
+    freq_buckets_free(&buckets);
+    if (st != STATUS_OK) collinear_sets_free(out);
+    return st;
+}
+
+/**
+ * @fn collinear_sets_free
+ * @brief Frees the resources of a CollinearSets structure.
+ * @param s Pointer to the sets.
+ */
+void collinear_sets_free(CollinearSets *s) {
+    if (!s) return;
+    free(s->set);
+    free(s->members);
+    s->set = NULL;
+    s->count = 0;
+    s->members = NULL;
+}
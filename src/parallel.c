@@ -0,0 +1,471 @@
+/**
+ * @file parallel.c
+ * @brief Implementation of the fork-join thread pool.
+ *
+ * Workers pull task numbers from a shared counter guarded by a mutex, so
+ * the pool needs nothing beyond <threads.h>. Tasks are expected to be
+ * coarse (a frequency, a chunk of rows), which keeps the lock cheap.
+ * parallel_for_steal() gives every worker its own locked deque instead, so
+ * workers only contend when one of them runs dry and steals.
+ * parallel_team() is for algorithms that advance in lock-step rounds: the
+ * workers run concurrently for the whole call and meet at team_barrier().
+ *
+ * @author Ahmet Abdullah GULTEKIN
+ * @date 2025-05-25
+ *
+ * @see parallel.h for the header file containing the function prototypes.
+ */
+
+#include <stdlib.h>     /* malloc, free */
+#include <threads.h>    /* thrd_t, mtx_t, cnd_t */
+#if defined(_WIN32)
+#include <Windows.h>    /* GetSystemInfo */
+#else
+#include <unistd.h>     /* sysconf */
+#endif
+#include "../include/parallel.h"
+
+/**
+ * @struct Pool
+ *
+ * @brief Shared state of one parallel_for() call.
+ */
+typedef struct {
+    TaskFn fn;           /* task function                       */
+    void *ctx;           /* user context                        */
+    size_t n_tasks;      /* total number of tasks               */
+    size_t next;         /* next task to hand out               */
+    Status st;           /* first error reported by a task      */
+    mtx_t lock;          /* guards next and st                  */
+} Pool;
+
+/**
+ * @fn parallel_default_workers
+ * @brief Returns the number of online processors.
+ * @return The processor count, at least 1.
+ */
+size_t parallel_default_workers(void) {
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors ? (size_t) info.dwNumberOfProcessors : 1;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (size_t) n : 1;
+#endif
+}
+
+/**
+ * @fn parallel_worker_count
+ * @brief Resolves the worker count for a given number of tasks.
+ * @param n_workers Requested worker count (0 for the default).
+ * @param n_tasks Number of tasks.
+ * @return The worker count, at least 1 and at most n_tasks.
+ */
+size_t parallel_worker_count(size_t n_workers, size_t n_tasks) {
+    if (n_workers == 0) n_workers = parallel_default_workers();
+    if (n_workers > n_tasks) n_workers = n_tasks;
+    return n_workers ? n_workers : 1;
+}
+
+/**
+ * @fn run_worker
+ * @brief Executes tasks until none are left or a task fails.
+ * @param pool Shared pool state.
+ * @param worker Worker index.
+ */
+static void run_worker(Pool *pool, size_t worker) {
+    for (;;) {
+        mtx_lock(&pool->lock);
+        size_t task = pool->next;
+        bool done = pool->st != STATUS_OK || task >= pool->n_tasks;
+        if (!done) pool->next++;
+        mtx_unlock(&pool->lock);
+        if (done) return;
+
+        Status st = pool->fn(task, worker, pool->ctx);
+        if (st != STATUS_OK) {
+            mtx_lock(&pool->lock);
+            if (pool->st == STATUS_OK) pool->st = st;
+            mtx_unlock(&pool->lock);
+            return;
+        }
+    }
+}
+
+/**
+ * @struct Deque
+ *
+ * @brief Range of task numbers owned by one worker of parallel_for_steal().
+ * The owner pops from the low end, thieves steal from the high end.
+ */
+typedef struct {
+    size_t lo;           /* next task of the owner              */
+    size_t hi;           /* one past the last task              */
+    mtx_t lock;          /* guards lo and hi                    */
+} Deque;
+
+/**
+ * @struct StealPool
+ *
+ * @brief Shared state of one parallel_for_steal() call.
+ */
+typedef struct {
+    TaskFn fn;           /* task function                        */
+    void *ctx;           /* user context                         */
+    size_t n_tasks;      /* total number of tasks                */
+    size_t n_workers;    /* number of filled deques              */
+    Deque *dq;           /* one deque per worker                 */
+    bool ready;          /* deques are filled, workers may start */
+    Status st;           /* first error reported by a task       */
+    mtx_t lock;          /* guards ready and st                  */
+    cnd_t cond;          /* signals ready                        */
+} StealPool;
+
+/**
+ * @struct WorkerArg
+ *
+ * @brief Argument of one worker thread.
+ */
+typedef struct {
+    void *pool;                           /* Pool or StealPool   */
+    void (*run)(void *pool, size_t worker); /* worker loop       */
+    size_t worker;                        /* worker index        */
+} WorkerArg;
+
+/**
+ * @fn run_pool_worker
+ * @brief Adapts run_worker() to the worker loop signature.
+ * @param pool Pointer to the Pool.
+ * @param worker Worker index.
+ */
+static void run_pool_worker(void *pool, size_t worker) {
+    run_worker(pool, worker);
+}
+
+/**
+ * @fn worker_main
+ * @brief Thread entry point.
+ * @param arg Pointer to the WorkerArg of this thread.
+ * @return Always 0.
+ */
+static int worker_main(void *arg) {
+    WorkerArg *wa = arg;
+    wa->run(wa->pool, wa->worker);
+    return 0;
+}
+
+/**
+ * @fn spawn_and_join
+ * @brief Runs a worker loop on n_workers threads, the caller being worker 0.
+ * @param n_workers Number of workers (at least 2).
+ * @param run Worker loop.
+ * @param started_fn Optional function told the number of workers actually running,
+ * called before the caller enters the loop.
+ * @param pool Shared state passed to the loop.
+ * @return Status indicating success or failure.
+ */
+static Status spawn_and_join(size_t n_workers, void (*run)(void *pool, size_t worker),
+                             void (*started_fn)(void *pool, size_t size), void *pool) {
+    thrd_t *threads = malloc((n_workers - 1) * sizeof(thrd_t));
+    WorkerArg *args = malloc((n_workers - 1) * sizeof(WorkerArg));
+    if (!threads || !args) {
+        free(threads);
+        free(args);
+        return STATUS_ALLOC;
+    }
+
+    // Worker 0 is the calling thread; a failed spawn just means fewer helpers,
+    // and workers are numbered densely so the live ones are 0 .. started
+    size_t started = 0;
+    for (size_t w = 1; w < n_workers; ++w) {
+        args[started] = (WorkerArg) {.pool = pool, .run = run, .worker = started + 1};
+        if (thrd_create(&threads[started], worker_main, &args[started]) == thrd_success) started++;
+    }
+    if (started_fn) started_fn(pool, started + 1);
+    run(pool, 0);
+    for (size_t i = 0; i < started; ++i) thrd_join(threads[i], NULL);
+
+    free(threads);
+    free(args);
+    return STATUS_OK;
+}
+
+/**
+ * @fn parallel_for
+ * @brief Runs n_tasks tasks on a pool of worker threads and waits for them.
+ * @param n_tasks Number of tasks.
+ * @param n_workers Number of workers (0 for the default).
+ * @param fn Task function.
+ * @param ctx Context pointer passed to the task function.
+ * @return Status indicating success or the first failure.
+ */
+Status parallel_for(size_t n_tasks, size_t n_workers, TaskFn fn, void *ctx) {
+    if (!fn) return STATUS_INVALID;
+    if (n_tasks == 0) return STATUS_OK;
+
+    n_workers = parallel_worker_count(n_workers, n_tasks);
+    if (n_workers == 1) {
+        for (size_t t = 0; t < n_tasks; ++t) {
+            Status st = fn(t, 0, ctx);
+            if (st != STATUS_OK) return st;
+        }
+        return STATUS_OK;
+    }
+
+    Pool pool = {.fn = fn, .ctx = ctx, .n_tasks = n_tasks, .next = 0, .st = STATUS_OK};
+    if (mtx_init(&pool.lock, mtx_plain) != thrd_success) return STATUS_ALLOC;
+
+    Status st = spawn_and_join(n_workers, run_pool_worker, NULL, &pool);
+    mtx_destroy(&pool.lock);
+    return st != STATUS_OK ? st : pool.st;
+}
+
+/**
+ * @fn take_task
+ * @brief Pops a task from the own deque, or steals one from another worker.
+ * @param pool Shared pool state.
+ * @param worker Worker index.
+ * @param task Pointer to store the task number.
+ * @return True if a task was found, false if every deque is empty.
+ */
+static bool take_task(StealPool *pool, size_t worker, size_t *task) {
+    Deque *own = &pool->dq[worker];
+    mtx_lock(&own->lock);
+    bool found = own->lo < own->hi;
+    if (found) *task = own->lo++;
+    mtx_unlock(&own->lock);
+    if (found) return true;
+
+    // Tasks are never added, so one empty sweep over the victims means we are done
+    for (size_t i = 1; i < pool->n_workers; ++i) {
+        Deque *victim = &pool->dq[(worker + i) % pool->n_workers];
+        mtx_lock(&victim->lock);
+        found = victim->lo < victim->hi;
+        if (found) *task = --victim->hi;
+        mtx_unlock(&victim->lock);
+        if (found) return true;
+    }
+    return false;
+}
+
+/**
+ * @fn run_steal_worker
+ * @brief Executes tasks until every deque is empty or a task fails.
+ * @param arg Pointer to the StealPool.
+ * @param worker Worker index.
+ */
+static void run_steal_worker(void *arg, size_t worker) {
+    StealPool *pool = arg;
+    mtx_lock(&pool->lock);
+    while (!pool->ready) cnd_wait(&pool->cond, &pool->lock);
+    mtx_unlock(&pool->lock);
+
+    size_t task;
+    while (take_task(pool, worker, &task)) {
+        mtx_lock(&pool->lock);
+        bool failed = pool->st != STATUS_OK;
+        mtx_unlock(&pool->lock);
+        if (failed) return;
+
+        Status st = pool->fn(task, worker, pool->ctx);
+        if (st != STATUS_OK) {
+            mtx_lock(&pool->lock);
+            if (pool->st == STATUS_OK) pool->st = st;
+            mtx_unlock(&pool->lock);
+            return;
+        }
+    }
+}
+
+/**
+ * @fn steal_pool_ready
+ * @brief Splits the tasks over the workers that actually started and lets them run.
+ * @details Every deque then has a live owner, which pops its tasks in increasing order.
+ * @param arg Pointer to the StealPool.
+ * @param size Number of running workers.
+ */
+static void steal_pool_ready(void *arg, size_t size) {
+    StealPool *pool = arg;
+    mtx_lock(&pool->lock);
+    // Each worker starts with a contiguous block of tasks
+    for (size_t w = 0; w < size; ++w) {
+        pool->dq[w].lo = pool->n_tasks * w / size;
+        pool->dq[w].hi = pool->n_tasks * (w + 1) / size;
+    }
+    pool->n_workers = size;
+    pool->ready = true;
+    cnd_broadcast(&pool->cond);
+    mtx_unlock(&pool->lock);
+}
+
+/**
+ * @fn parallel_for_steal
+ * @brief Runs n_tasks tasks on per-worker deques with work stealing.
+ * @param n_tasks Number of tasks.
+ * @param n_workers Number of workers (0 for the default).
+ * @param fn Task function.
+ * @param ctx Context pointer passed to the task function.
+ * @return Status indicating success or the first failure.
+ */
+Status parallel_for_steal(size_t n_tasks, size_t n_workers, TaskFn fn, void *ctx) {
+    if (!fn) return STATUS_INVALID;
+    if (n_tasks == 0) return STATUS_OK;
+
+    n_workers = parallel_worker_count(n_workers, n_tasks);
+    if (n_workers == 1) return parallel_for(n_tasks, 1, fn, ctx);
+
+    StealPool pool = {.fn = fn, .ctx = ctx, .n_tasks = n_tasks, .st = STATUS_OK};
+    pool.dq = malloc(n_workers * sizeof(Deque));
+    if (!pool.dq) return STATUS_ALLOC;
+    if (mtx_init(&pool.lock, mtx_plain) != thrd_success) {
+        free(pool.dq);
+        return STATUS_ALLOC;
+    }
+    if (cnd_init(&pool.cond) != thrd_success) {
+        mtx_destroy(&pool.lock);
+        free(pool.dq);
+        return STATUS_ALLOC;
+    }
+
+    // Deques are filled by steal_pool_ready once the running workers are known,
+    // so a failed spawn never leaves tasks in a deque nobody owns
+    size_t ready = 0;
+    Status st = STATUS_OK;
+    for (; ready < n_workers; ++ready) {
+        if (mtx_init(&pool.dq[ready].lock, mtx_plain) != thrd_success) {
+            st = STATUS_ALLOC;
+            break;
+        }
+    }
+    if (st == STATUS_OK) st = spawn_and_join(n_workers, run_steal_worker, steal_pool_ready, &pool);
+
+    for (size_t w = 0; w < ready; ++w) mtx_destroy(&pool.dq[w].lock);
+    cnd_destroy(&pool.cond);
+    mtx_destroy(&pool.lock);
+    free(pool.dq);
+    return st != STATUS_OK ? st : pool.st;
+}
+
+/**
+ * @struct Team
+ *
+ * @brief Shared state of one parallel_team() call.
+ */
+struct Team {
+    TeamFn fn;           /* worker function                     */
+    void *ctx;           /* user context                        */
+    size_t size;         /* workers taking part                 */
+    bool ready;          /* size is final, workers may start    */
+    size_t arrived;      /* workers waiting at the barrier      */
+    size_t generation;   /* barrier round                       */
+    Status st;           /* first error reported by a worker    */
+    mtx_t lock;          /* guards everything above             */
+    cnd_t cond;          /* signals ready and barrier rounds    */
+};
+
+/**
+ * @struct TeamArg
+ *
+ * @brief Argument of one team thread.
+ */
+typedef struct {
+    Team *team;
+    size_t worker;       /* worker index                        */
+} TeamArg;
+
+/**
+ * @fn run_team_worker
+ * @brief Waits until the team size is final, then runs the worker function.
+ * @param team Shared team state.
+ * @param worker Worker index.
+ */
+static void run_team_worker(Team *team, size_t worker) {
+    mtx_lock(&team->lock);
+    while (!team->ready) cnd_wait(&team->cond, &team->lock);
+    size_t size = team->size;
+    mtx_unlock(&team->lock);
+
+    Status st = team->fn(team, worker, size, team->ctx);
+    if (st != STATUS_OK) {
+        mtx_lock(&team->lock);
+        if (team->st == STATUS_OK) team->st = st;
+        mtx_unlock(&team->lock);
+    }
+}
+
+/**
+ * @fn team_main
+ * @brief Team thread entry point.
+ * @param arg Pointer to the TeamArg of this thread.
+ * @return Always 0.
+ */
+static int team_main(void *arg) {
+    TeamArg *ta = arg;
+    run_team_worker(ta->team, ta->worker);
+    return 0;
+}
+
+/**
+ * @fn team_barrier
+ * @brief Blocks until every worker of the team has reached the barrier.
+ * @param team Pointer to the team.
+ */
+void team_barrier(Team *team) {
+    mtx_lock(&team->lock);
+    size_t generation = team->generation;
+    if (++team->arrived == team->size) {
+        team->arrived = 0;
+        team->generation++;
+        cnd_broadcast(&team->cond);
+    } else {
+        while (generation == team->generation) cnd_wait(&team->cond, &team->lock);
+    }
+    mtx_unlock(&team->lock);
+}
+
+/**
+ * @fn parallel_team
+ * @brief Runs a worker function on a team of concurrent threads and waits for them.
+ * @param n_workers Number of workers (0 for the default).
+ * @param fn Worker function.
+ * @param ctx Context pointer passed to the worker function.
+ * @return Status indicating success or the first failure.
+ */
+Status parallel_team(size_t n_workers, TeamFn fn, void *ctx) {
+    if (!fn) return STATUS_INVALID;
+    if (n_workers == 0) n_workers = parallel_default_workers();
+
+    Team team = {.fn = fn, .ctx = ctx, .size = 1, .ready = false, .st = STATUS_OK};
+    if (mtx_init(&team.lock, mtx_plain) != thrd_success) return STATUS_ALLOC;
+    if (cnd_init(&team.cond) != thrd_success) {
+        mtx_destroy(&team.lock);
+        return STATUS_ALLOC;
+    }
+
+    thrd_t *threads = n_workers > 1 ? malloc((n_workers - 1) * sizeof(thrd_t)) : NULL;
+    TeamArg *args = n_workers > 1 ? malloc((n_workers - 1) * sizeof(TeamArg)) : NULL;
+    size_t started = 0;
+    if (threads && args) {
+        // Workers are numbered densely, so a failed spawn only shrinks the team
+        for (size_t w = 1; w < n_workers; ++w) {
+            args[started] = (TeamArg) {.team = &team, .worker = started + 1};
+            if (thrd_create(&threads[started], team_main, &args[started]) == thrd_success) started++;
+        }
+    }
+
+    mtx_lock(&team.lock);
+    team.size = started + 1;
+    team.ready = true;
+    cnd_broadcast(&team.cond);
+    mtx_unlock(&team.lock);
+
+    run_team_worker(&team, 0);
+    for (size_t i = 0; i < started; ++i) thrd_join(threads[i], NULL);
+
+    free(threads);
+    free(args);
+    cnd_destroy(&team.cond);
+    mtx_destroy(&team.lock);
+    return team.st;
+}
@@ -0,0 +1,656 @@
+/**
+ * @file paths.c
+ * @brief Implementation of the parallel and weighted path search functions.
+ *
+ * The search tree of graph_for_each_path() is split into path prefixes by
+ * expanding it level by level, in DFS order, until there are enough prefixes
+ * to keep every worker busy. Each prefix is then searched to completion by
+ * one worker with the same iterative DFS as the sequential version.
+ *
+ * Shortest paths use an indexed binary heap with decrease-key; the edge
+ * weights are never stored, they are recomputed from the vertex coordinates.
+ *
+ * @author Ahmet Abdullah GULTEKIN
+ * @date 2025-05-25
+ *
+ * @see paths.h for the header file containing the function prototypes.
+ */
+
+#include <stdlib.h>     /* malloc, realloc, free */
+#include <string.h>     /* memcpy, memset */
+#include <threads.h>    /* mtx_t, cnd_t */
+#include "../include/paths.h"
+#include "../include/parallel.h"
+
+/**
+ * A task hands its buffered paths to the callback once they take this many words.
+ */
+#define PATH_BUF_FLUSH 4096
+
+/**
+ * @struct PathBuf
+ *
+ * @brief PathBuf structure buffering the paths found by one task.
+ * Each path is stored as its length followed by its vertex indices.
+ */
+typedef struct {
+    size_t *data;        /* length-prefixed paths               */
+    size_t used;         /* words in use                        */
+    size_t cap;          /* allocated words                     */
+} PathBuf;
+
+/**
+ * @struct Prefixes
+ *
+ * @brief Prefixes structure holding the path prefixes, one per task.
+ */
+typedef struct {
+    size_t *idx;         /* vertices of all prefixes            */
+    size_t *off;         /* start of each prefix in idx         */
+    size_t *len;         /* length of each prefix               */
+    size_t count;        /* number of prefixes                  */
+    size_t used;         /* entries of idx in use               */
+    size_t cap_idx;      /* allocated entries of idx            */
+    size_t cap;          /* allocated prefixes                  */
+} Prefixes;
+
+/**
+ * @struct PathJob
+ *
+ * @brief Shared state of one graph_for_each_path_parallel() call.
+ */
+typedef struct {
+    const Graph *g;
+    size_t dst;
+    size_t max_paths;
+    size_t max_depth;
+    uint64_t deadline;   /* wall-clock end in ms, 0 for none    */
+    bool ordered;
+    PathFn fn;
+    void *ctx;
+    Prefixes pre;        /* one prefix per task                 */
+    size_t words;        /* words of one visited bitmap         */
+    uint64_t *visited;   /* per-worker visited bitmaps          */
+    size_t *stack;       /* per-worker path stacks              */
+    EdgeNode **next;     /* per-worker next-edge stacks         */
+    PathBuf *buf;        /* per-task path buffers               */
+    bool *done;          /* finished tasks (ordered mode)       */
+    size_t next_emit;    /* first task not yet delivered        */
+    size_t emitted;      /* paths delivered to fn               */
+    bool stop;           /* no more paths are wanted            */
+    bool cut;            /* some limit hid paths                */
+    Status st;           /* first error                         */
+    mtx_t lock;          /* guards everything below pre         */
+    cnd_t turn;          /* signals next_emit and stop changes  */
+} PathJob;
+
+/**
+ * @fn prefixes_push
+ * @brief Appends a prefix.
+ * @param p Pointer to the prefixes.
+ * @param path Vertices of the prefix.
+ * @param len Length of the prefix.
+ * @param extra Optional vertex appended after path, SIZE_MAX for none.
+ * @return Status indicating success or failure.
+ */
+static Status prefixes_push(Prefixes *p, const size_t *path, size_t len, size_t extra) {
+    size_t total = len + (extra != SIZE_MAX);
+    if (p->count == p->cap) {
+        size_t cap = p->cap ? p->cap * 2 : 16;
+        size_t *off = realloc(p->off, cap * sizeof(size_t));
+        if (!off) return STATUS_ALLOC;
+        p->off = off;
+        size_t *lens = realloc(p->len, cap * sizeof(size_t));
+        if (!lens) return STATUS_ALLOC;
+        p->len = lens;
+        p->cap = cap;
+    }
+    if (p->used + total > p->cap_idx) {
+        size_t cap = p->cap_idx ? p->cap_idx : 64;
+        while (cap < p->used + total) cap *= 2;
+        size_t *idx = realloc(p->idx, cap * sizeof(size_t));
+        if (!idx) return STATUS_ALLOC;
+        p->idx = idx;
+        p->cap_idx = cap;
+    }
+    memcpy(p->idx + p->used, path, len * sizeof(size_t));
+    if (extra != SIZE_MAX) p->idx[p->used + len] = extra;
+    p->off[p->count] = p->used;
+    p->len[p->count++] = total;
+    p->used += total;
+    return STATUS_OK;
+}
+
+/**
+ * @fn prefixes_free
+ * @brief Frees the resources of a prefix list.
+ * @param p Pointer to the prefixes.
+ */
+static void prefixes_free(Prefixes *p) {
+    free(p->idx);
+    free(p->off);
+    free(p->len);
+    *p = (Prefixes) {0};
+}
+
+/**
+ * @fn on_prefix
+ * @brief Checks whether a vertex is already on a prefix.
+ * @param path Vertices of the prefix.
+ * @param len Length of the prefix.
+ * @param v Vertex to look for.
+ * @return True if v is on the prefix, false otherwise.
+ */
+static inline bool on_prefix(const size_t *path, size_t len, size_t v) {
+    for (size_t i = 0; i < len; ++i) if (path[i] == v) return true;
+    return false;
+}
+
+/**
+ * @fn split_tree
+ * @brief Expands the search tree level by level into at least target prefixes.
+ * @details Children are generated in adjacency order, so the prefixes stay in
+ * DFS order. Prefixes ending at dst are complete paths and are kept as they are;
+ * prefixes that can no longer grow without reaching dst are dropped.
+ * @param job Pointer to the job (g, dst and max_depth are used).
+ * @param src Source vertex index.
+ * @param target Wanted number of prefixes.
+ * @return Status indicating success or failure.
+ */
+static Status split_tree(PathJob *job, size_t src, size_t target) {
+    Prefixes cur = {0};
+    Status st = prefixes_push(&cur, &src, 1, SIZE_MAX);
+
+    while (st == STATUS_OK && cur.count < target) {
+        Prefixes nxt = {0};
+        bool grown = false;
+        for (size_t i = 0; st == STATUS_OK && i < cur.count; ++i) {
+            const size_t *path = cur.idx + cur.off[i];
+            size_t len = cur.len[i];
+            size_t last = path[len - 1];
+            if (last == job->dst || (job->max_depth && len > job->max_depth)) {
+                // Complete path, or left to the task to report the depth cut
+                st = prefixes_push(&nxt, path, len, SIZE_MAX);
+                continue;
+            }
+            for (EdgeNode *e = job->g->adj[last]; e && st == STATUS_OK; e = e->next) {
+                if (on_prefix(path, len, e->dest)) continue;
+                st = prefixes_push(&nxt, path, len, e->dest);
+                grown = true;
+            }
+        }
+        prefixes_free(&cur);
+        cur = nxt;
+        if (!grown) break;
+    }
+
+    if (st != STATUS_OK) {
+        prefixes_free(&cur);
+        return st;
+    }
+    job->pre = cur;
+    return STATUS_OK;
+}
+
+/**
+ * @fn buf_push
+ * @brief Appends a path to a buffer.
+ * @param b Pointer to the buffer.
+ * @param path Vertices of the path.
+ * @param len Length of the path.
+ * @return Status indicating success or failure.
+ */
+static Status buf_push(PathBuf *b, const size_t *path, size_t len) {
+    if (b->used + len + 1 > b->cap) {
+        size_t cap = b->cap ? b->cap : 64;
+        while (cap < b->used + len + 1) cap *= 2;
+        size_t *data = realloc(b->data, cap * sizeof(size_t));
+        if (!data) return STATUS_ALLOC;
+        b->data = data;
+        b->cap = cap;
+    }
+    b->data[b->used++] = len;
+    memcpy(b->data + b->used, path, len * sizeof(size_t));
+    b->used += len;
+    return STATUS_OK;
+}
+
+/**
+ * @fn emit
+ * @brief Hands the paths of a buffer to the callback and empties it; the lock must be held.
+ * @param job Pointer to the job.
+ * @param b Pointer to the buffer.
+ */
+static void emit(PathJob *job, PathBuf *b) {
+    for (size_t i = 0; i < b->used && !job->stop; i += b->data[i] + 1) {
+        Status st = job->fn(b->data + i + 1, b->data[i], job->ctx);
+        job->emitted++;
+        if (st == STATUS_STOP || (job->max_paths && job->emitted >= job->max_paths)) {
+            job->stop = true;
+            job->cut = true;
+        } else if (st != STATUS_OK) {
+            job->stop = true;
+            if (job->st == STATUS_OK) job->st = st;
+        }
+    }
+    b->used = 0;
+}
+
+/**
+ * @fn flush_partial
+ * @brief Delivers the full buffer of a running task, waiting for its turn in ordered mode.
+ * @details Waiting bounds every buffer to about PATH_BUF_FLUSH words. It cannot
+ * deadlock: parallel_for_steal only fills the deques of workers that actually
+ * started, and an owner pops its own tasks in increasing order before stealing, so
+ * the task at next_emit is either running or next in line for a live owner that is
+ * not itself waiting.
+ * @param job Pointer to the job.
+ * @param task Task number.
+ * @return True if the search should stop, false otherwise.
+ */
+static bool flush_partial(PathJob *job, size_t task) {
+    mtx_lock(&job->lock);
+    while (job->ordered && task != job->next_emit && !job->stop) cnd_wait(&job->turn, &job->lock);
+    emit(job, &job->buf[task]);
+    bool stop = job->stop;
+    if (stop) cnd_broadcast(&job->turn);
+    mtx_unlock(&job->lock);
+    return stop;
+}
+
+/**
+ * @fn finish_task
+ * @brief Records the end of a task and delivers every buffer that is ready.
+ * @param job Pointer to the job.
+ * @param task Task number.
+ * @param st Status of the task.
+ * @param cut True if a limit hid paths in this task.
+ * @return STATUS_STOP if the search should stop, STATUS_OK otherwise.
+ */
+static Status finish_task(PathJob *job, size_t task, Status st, bool cut) {
+    mtx_lock(&job->lock);
+    if (cut) job->cut = true;
+    if (st != STATUS_OK) {
+        job->stop = true;
+        if (job->st == STATUS_OK) job->st = st;
+    }
+    job->done[task] = true;
+    if (!job->ordered) {
+        emit(job, &job->buf[task]);
+    } else {
+        for (; job->next_emit < job->pre.count && job->done[job->next_emit]; ++job->next_emit) {
+            emit(job, &job->buf[job->next_emit]);
+        }
+    }
+    // Wake the tasks waiting for their turn, or for the stop
+    cnd_broadcast(&job->turn);
+    bool stop = job->stop;
+    mtx_unlock(&job->lock);
+    return stop ? STATUS_STOP : STATUS_OK;
+}
+
+/**
+ * @fn path_task
+ * @brief Searches every path below one prefix.
+ * @param task Task (prefix) number.
+ * @param worker Worker index.
+ * @param ctx Pointer to the PathJob.
+ * @return Status indicating whether the search continues.
+ */
+static Status path_task(size_t task, size_t worker, void *ctx) {
+    PathJob *job = ctx;
+    const Graph *g = job->g;
+    uint64_t *vis = job->visited + worker * job->words;
+    size_t *path = job->stack + worker * g->n;
+    EdgeNode **next = job->next + worker * g->n;
+    PathBuf *buf = &job->buf[task];
+
+    size_t base = job->pre.len[task];
+    memcpy(path, job->pre.idx + job->pre.off[task], base * sizeof(size_t));
+    memset(vis, 0, job->words * sizeof(uint64_t));
+    for (size_t i = 0; i < base; ++i) vis[path[i] >> 6] |= (uint64_t) 1 << (path[i] & 63);
+
+    Status st = STATUS_OK;
+    bool cut = false;
+    if (path[base - 1] == job->dst) return finish_task(job, task, buf_push(buf, path, base), false);
+
+    size_t len = base, steps = 0;
+    next[len - 1] = g->adj[path[len - 1]];
+    while (len >= base) {
+        if (++steps % PATH_CLOCK_STRIDE == 0) {
+            if (job->deadline && now_ms() >= job->deadline) {
+                cut = true;
+                break;
+            }
+            mtx_lock(&job->lock);
+            bool stop = job->stop;
+            mtx_unlock(&job->lock);
+            if (stop) break;
+        }
+
+        EdgeNode *e = next[len - 1];
+        while (e && (vis[e->dest >> 6] >> (e->dest & 63) & 1)) e = e->next;
+        if (e && job->max_depth && len > job->max_depth) {
+            cut = true;
+            e = NULL;
+        }
+        if (!e) {
+            --len;
+            vis[path[len] >> 6] &= ~((uint64_t) 1 << (path[len] & 63));
+            continue;
+        }
+
+        next[len - 1] = e->next;
+        path[len++] = e->dest;
+        if (e->dest == job->dst) {
+            st = buf_push(buf, path, len--);
+            if (st != STATUS_OK) break;
+            if (buf->used >= PATH_BUF_FLUSH && flush_partial(job, task)) break;
+            continue;
+        }
+        vis[e->dest >> 6] |= (uint64_t) 1 << (e->dest & 63);
+        next[len - 1] = g->adj[e->dest];
+    }
+    return finish_task(job, task, st, cut);
+}
+
+/**
+ * @fn graph_for_each_path_parallel
+ * @brief Streams every simple path from src to dst to a callback, in parallel.
+ * @param g Pointer to the graph.
+ * @param src Source vertex index.
+ * @param dst Destination vertex index.
+ * @param limits Optional limits, NULL for none.
+ * @param n_workers Number of worker threads (0 for one per processor).
+ * @param ordered Deliver the paths in sequential DFS order.
+ * @param fn Callback receiving each path.
+ * @param ctx User context passed to the callback.
+ * @param truncated Optional output, true if the search stopped early.
+ * @return Status indicating success or failure.
+ */
+Status graph_for_each_path_parallel(const Graph *g, size_t src, size_t dst, const PathLimits *limits,
+                                    size_t n_workers, bool ordered, PathFn fn, void *ctx, bool *truncated) {
+    if (!g || src >= g->n || dst >= g->n || !fn) return STATUS_INVALID;
+
+    PathJob job = {
+            .g = g, .dst = dst, .ordered = ordered, .fn = fn, .ctx = ctx,
+            .max_paths = limits ? limits->max_paths : 0,
+            .max_depth = limits ? limits->max_depth : 0,
+            .deadline = limits && limits->max_ms ? now_ms() + limits->max_ms : 0,
+            .words = (g->n + 63) / 64
+    };
+    n_workers = n_workers ? n_workers : parallel_default_workers();
+
+    Status st = split_tree(&job, src, n_workers * PATH_TASKS_PER_WORKER);
+    if (st != STATUS_OK) return st;
+    size_t n_tasks = job.pre.count;
+    n_workers = parallel_worker_count(n_workers, n_tasks);
+
+    job.visited = malloc(n_workers * job.words * sizeof(uint64_t));
+    job.stack = malloc(n_workers * g->n * sizeof(size_t));
+    job.next = malloc(n_workers * g->n * sizeof(EdgeNode *));
+    job.buf = calloc(n_tasks ? n_tasks : 1, sizeof(PathBuf));
+    job.done = calloc(n_tasks ? n_tasks : 1, sizeof(bool));
+    if (!job.visited || !job.stack || !job.next || !job.buf || !job.done) {
+        st = STATUS_ALLOC;
+    } else if (mtx_init(&job.lock, mtx_plain) != thrd_success) {
+        st = STATUS_ALLOC;
+    } else if (cnd_init(&job.turn) != thrd_success) {
+        mtx_destroy(&job.lock);
+        st = STATUS_ALLOC;
+    } else {
+        st = parallel_for_steal(n_tasks, n_workers, path_task, &job);
+        if (st == STATUS_STOP) st = STATUS_OK;
+        if (st == STATUS_OK) st = job.st;
+        cnd_destroy(&job.turn);
+        mtx_destroy(&job.lock);
+    }
+
+    if (truncated) *truncated = job.cut;
+    if (job.buf) {
+        for (size_t t = 0; t < n_tasks; ++t) free(job.buf[t].data);
+    }
+    free(job.visited);
+    free(job.stack);
+    free(job.next);
+    free(job.buf);
+    free(job.done);
+    prefixes_free(&job.pre);
+    return st;
+}
+
+/**
+ * @fn path_workspace_init
+ * @brief Initializes a workspace for graphs of up to n vertices.
+ * @param ws Pointer to the workspace.
+ * @param n Expected number of vertices.
+ * @return Status indicating success or failure.
+ */
+Status path_workspace_init(PathWorkspace *ws, size_t n) {
+    if (!ws) return STATUS_INVALID;
+    *ws = (PathWorkspace) {0};
+    if (n == 0) return STATUS_OK;
+
+    ws->stamp = calloc(n, sizeof(uint32_t));
+    ws->dist = malloc(n * sizeof(double));
+    ws->key = malloc(n * sizeof(double));
+    ws->prev = malloc(n * sizeof(size_t));
+    ws->pos = malloc(n * sizeof(size_t));
+    ws->heap = malloc(n * sizeof(size_t));
+    if (!ws->stamp || !ws->dist || !ws->key || !ws->prev || !ws->pos || !ws->heap) {
+        path_workspace_free(ws);
+        return STATUS_ALLOC;
+    }
+    ws->cap = n;
+    return STATUS_OK;
+}
+
+/**
+ * @fn path_workspace_free
+ * @brief Frees the resources of a workspace.
+ * @param ws Pointer to the workspace.
+ */
+void path_workspace_free(PathWorkspace *ws) {
+    if (!ws) return;
+    free(ws->stamp);
+    free(ws->dist);
+    free(ws->key);
+    free(ws->prev);
+    free(ws->pos);
+    free(ws->heap);
+    *ws = (PathWorkspace) {0};
+}
+
+/**
+ * @fn heap_swap
+ * @brief Swaps two heap slots and updates the positions of their vertices.
+ * @param ws Pointer to the workspace.
+ * @param i First slot.
+ * @param j Second slot.
+ */
+static inline void heap_swap(PathWorkspace *ws, size_t i, size_t j) {
+    size_t a = ws->heap[i], b = ws->heap[j];
+    ws->heap[i] = b;
+    ws->heap[j] = a;
+    ws->pos[b] = i;
+    ws->pos[a] = j;
+}
+
+/**
+ * @fn heap_up
+ * @brief Moves a heap slot up until its parent has a smaller key.
+ * @param ws Pointer to the workspace.
+ * @param i Slot to move.
+ */
+static void heap_up(PathWorkspace *ws, size_t i) {
+    while (i > 0) {
+        size_t parent = (i - 1) / 2;
+        if (ws->key[ws->heap[parent]] <= ws->key[ws->heap[i]]) break;
+        heap_swap(ws, i, parent);
+        i = parent;
+    }
+}
+
+/**
+ * @fn heap_pop
+ * @brief Removes the vertex with the smallest key and marks it settled.
+ * @param ws Pointer to the workspace.
+ * @return The removed vertex.
+ */
+static size_t heap_pop(PathWorkspace *ws) {
+    size_t top = ws->heap[0];
+    ws->size--;
+    if (ws->size > 0) {
+        ws->heap[0] = ws->heap[ws->size];
+        ws->pos[ws->heap[0]] = 0;
+        size_t i = 0;
+        for (;;) {
+            size_t l = 2 * i + 1, r = l + 1, m = i;
+            if (l < ws->size && ws->key[ws->heap[l]] < ws->key[ws->heap[m]]) m = l;
+            if (r < ws->size && ws->key[ws->heap[r]] < ws->key[ws->heap[m]]) m = r;
+            if (m == i) break;
+            heap_swap(ws, i, m);
+            i = m;
+        }
+    }
+    ws->pos[top] = SIZE_MAX;
+    return top;
+}
+
+/**
+ * @fn shortest_path
+ * @brief Runs Dijkstra's algorithm, or A* when a heuristic is requested.
+ * @param g Pointer to the graph.
+ * @param src Source vertex index.
+ * @param dst Destination vertex index.
+ * @param metric Edge weight (and heuristic).
+ * @param astar True to guide the search with the distance to dst.
+ * @param ws Pointer to the workspace.
+ * @param out Pointer to the output path.
+ * @param cost Optional output cost.
+ * @return Status indicating success or failure.
+ */
+static Status shortest_path(const Graph *g, size_t src, size_t dst, Metric metric, bool astar,
+                            PathWorkspace *ws, Path *out, double *cost) {
+    if (ws->cap < g->n) {
+        path_workspace_free(ws);
+        Status st = path_workspace_init(ws, g->n);
+        if (st != STATUS_OK) return st;
+    }
+    if (++ws->epoch == 0) {
+        // The stamp wrapped around, forget every previous search
+        memset(ws->stamp, 0, ws->cap * sizeof(uint32_t));
+        ws->epoch = 1;
+    }
+
+    const Vertex *target = &g->v[dst];
+    ws->size = 0;
+    ws->stamp[src] = ws->epoch;
+    ws->dist[src] = 0.0;
+    ws->key[src] = astar ? metric_dist(&g->v[src], target, metric) : 0.0;
+    ws->prev[src] = SIZE_MAX;
+    ws->pos[src] = 0;
+    ws->heap[ws->size++] = src;
+
+    bool found = false;
+    while (ws->size > 0) {
+        size_t v = heap_pop(ws);
+        if (v == dst) {
+            found = true;
+            break;
+        }
+        for (EdgeNode *e = g->adj[v]; e; e = e->next) {
+            size_t u = e->dest;
+            double d = ws->dist[v] + metric_dist(&g->v[v], &g->v[u], metric);
+            if (ws->stamp[u] != ws->epoch) {
+                ws->stamp[u] = ws->epoch;
+                ws->dist[u] = d;
+                ws->key[u] = d + (astar ? metric_dist(&g->v[u], target, metric) : 0.0);
+                ws->prev[u] = v;
+                ws->pos[u] = ws->size;
+                ws->heap[ws->size++] = u;
+                heap_up(ws, ws->pos[u]);
+            } else if (ws->pos[u] != SIZE_MAX && d < ws->dist[u]) {
+                // The heuristic of u does not change, so the key drops by the same amount
+                ws->key[u] -= ws->dist[u] - d;
+                ws->dist[u] = d;
+                ws->prev[u] = v;
+                heap_up(ws, ws->pos[u]);
+            }
+        }
+    }
+    if (!found) return STATUS_NOT_FOUND;
+
+    size_t len = 0;
+    for (size_t v = dst; v != SIZE_MAX; v = ws->prev[v]) len++;
+    out->idx = malloc(len * sizeof(size_t));
+    if (!out->idx) return STATUS_ALLOC;
+    out->len = len;
+    for (size_t v = dst, i = len; v != SIZE_MAX; v = ws->prev[v]) out->idx[--i] = v;
+    if (cost) *cost = ws->dist[dst];
+    return STATUS_OK;
+}
+
+/**
+ * @fn run_shortest_path
+ * @brief Validates the arguments and runs shortest_path() with a workspace.
+ * @param g Pointer to the graph.
+ * @param src Source vertex index.
+ * @param dst Destination vertex index.
+ * @param metric Edge weight.
+ * @param astar True for A*, false for Dijkstra.
+ * @param ws Optional workspace, NULL for a temporary one.
+ * @param out Pointer to the output path.
+ * @param cost Optional output cost.
+ * @return Status indicating success or failure.
+ */
+static Status run_shortest_path(const Graph *g, size_t src, size_t dst, Metric metric, bool astar,
+                                PathWorkspace *ws, Path *out, double *cost) {
+    if (!g || src >= g->n || dst >= g->n || !out) return STATUS_INVALID;
+    if (metric != METRIC_EUCLIDEAN && metric != METRIC_MANHATTAN) return STATUS_INVALID;
+    out->idx = NULL;
+    out->len = 0;
+
+    if (ws) return shortest_path(g, src, dst, metric, astar, ws, out, cost);
+
+    PathWorkspace tmp;
+    Status st = path_workspace_init(&tmp, g->n);
+    if (st != STATUS_OK) return st;
+    st = shortest_path(g, src, dst, metric, astar, &tmp, out, cost);
+    path_workspace_free(&tmp);
+    return st;
+}
+
+/**
+ * @fn graph_dijkstra
+ * @brief Finds the cheapest path from src to dst with Dijkstra's algorithm.
+ * @param g Pointer to the graph.
+ * @param src Source vertex index.
+ * @param dst Destination vertex index.
+ * @param metric Edge weight.
+ * @param ws Optional workspace, NULL for a temporary one.
+ * @param out Pointer to the output path.
+ * @param cost Optional output cost.
+ * @return Status indicating success or failure.
+ */
+Status graph_dijkstra(const Graph *g, size_t src, size_t dst, Metric metric,
+                      PathWorkspace *ws, Path *out, double *cost) {
+    return run_shortest_path(g, src, dst, metric, false, ws, out, cost);
+}
+
+/**
+ * @fn graph_astar
+ * @brief Finds the cheapest path from src to dst with A*.
+ * @param g Pointer to the graph.
+ * @param src Source vertex index.
+ * @param dst Destination vertex index.
+ * @param metric Edge weight and heuristic.
+ * @param ws Optional workspace, NULL for a temporary one.
+ * @param out Pointer to the output path.
+ * @param cost Optional output cost.
+ * @return Status indicating success or failure.
+ */
+Status graph_astar(const Graph *g, size_t src, size_t dst, Metric metric,
+                   PathWorkspace *ws, Path *out, double *cost) {
+    return run_shortest_path(g, src, dst, metric, true, ws, out, cost);
+}
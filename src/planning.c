@@ -0,0 +1,603 @@
+/**
+ * @file planning.c
+ * @brief Implementation of the antenna planning tools.
+ *
+ * A new antenna at p forms a pair with every antenna b of its frequency, and
+ * the pair adds the antinodes 2p - b and 2b - p. The first kind are distinct
+ * for distinct b, and so are the second kind; an antinode of the second kind
+ * equals one of the first kind exactly when 3p - 2b is also an antenna of the
+ * frequency, so each candidate is scored without a per-candidate set.
+ *
+ * The reassignment keeps, in one CoordSet per frequency, the number of pairs
+ * that put an antinode on each cell, and in a combined set the number of
+ * frequencies with a non-zero count, as the DangerIndex does. A retune only
+ * touches the counts of the pairs the antenna leaves and joins, and a chain
+ * holds no more entries than there are antinodes.
+ *
+ * @author Ahmet Abdullah GULTEKIN
+ * @date 2025-05-25
+ *
+ * @see planning.h for the header file containing the function prototypes
+ * and data structures.
+ */
+
+#include <stdlib.h>     /* malloc, calloc, qsort, free */
+#include <string.h>     /* memcpy */
+#include <math.h>       /* exp, pow */
+#include "../include/planning.h"
+#include "../include/danger.h"
+#include "../include/parallel.h"
+
+/**
+ * @struct PlacementJob
+ *
+ * @brief Shared state of one graph_best_placements() call.
+ */
+typedef struct {
+    const Graph *g;
+    Region area;         /* candidate cells, inside the map     */
+    PlacementGoal goal;
+    const Coord *site;   /* distinct cells of the frequency's antennas */
+    size_t k;
+    const CoordSet *mine;  /* the same cells, for lookups       */
+    const CoordSet *taken; /* cells holding any antenna         */
+    const BitGrid *own;  /* danger cells of the frequency, NULL if none */
+    const BitGrid *any;  /* danger cells of all frequencies     */
+    size_t n_best;
+    Placement *heap;     /* n_best entries per worker           */
+    size_t *size;        /* entries in each worker's heap       */
+} PlacementJob;
+
+/**
+ * @fn rank
+ * @brief Orders two placements, best first.
+ * @param a First placement.
+ * @param b Second placement.
+ * @param goal Count compared first.
+ * @return Negative if a is better, positive if b is better, zero if they are the same cell.
+ */
+static int rank(const Placement *a, const Placement *b, PlacementGoal goal) {
+    size_t a1 = goal == PLACE_FEWEST_OVERLAPS ? a->new_overlaps : a->new_cells;
+    size_t b1 = goal == PLACE_FEWEST_OVERLAPS ? b->new_overlaps : b->new_cells;
+    size_t a2 = goal == PLACE_FEWEST_OVERLAPS ? a->new_cells : a->new_overlaps;
+    size_t b2 = goal == PLACE_FEWEST_OVERLAPS ? b->new_cells : b->new_overlaps;
+    if (a1 != b1) return a1 < b1 ? -1 : 1;
+    if (a2 != b2) return a2 < b2 ? -1 : 1;
+    if (a->cell.row != b->cell.row) return a->cell.row < b->cell.row ? -1 : 1;
+    return (a->cell.col > b->cell.col) - (a->cell.col < b->cell.col);
+}
+
+/**
+ * @fn by_cells
+ * @brief qsort comparator for PLACE_FEWEST_CELLS.
+ * @param a Pointer to the first placement.
+ * @param b Pointer to the second placement.
+ * @return Comparison result.
+ */
+static int by_cells(const void *a, const void *b) {
+    return rank(a, b, PLACE_FEWEST_CELLS);
+}
+
+/**
+ * @fn by_overlaps
+ * @brief qsort comparator for PLACE_FEWEST_OVERLAPS.
+ * @param a Pointer to the first placement.
+ * @param b Pointer to the second placement.
+ * @return Comparison result.
+ */
+static int by_overlaps(const void *a, const void *b) {
+    return rank(a, b, PLACE_FEWEST_OVERLAPS);
+}
+
+/**
+ * @fn heap_offer
+ * @brief Offers a placement to a bounded heap that keeps the best ones, worst at the root.
+ * @param heap Heap entries.
+ * @param size Pointer to the number of entries.
+ * @param cap Heap capacity.
+ * @param p Placement to offer.
+ * @param goal Count compared first.
+ */
+static void heap_offer(Placement *heap, size_t *size, size_t cap, Placement p, PlacementGoal goal) {
+    size_t i;
+    if (*size < cap) {
+        // Sift up past better parents
+        for (i = (*size)++; i > 0 && rank(&heap[(i - 1) / 2], &p, goal) < 0; i = (i - 1) / 2) {
+            heap[i] = heap[(i - 1) / 2];
+        }
+        heap[i] = p;
+        return;
+    }
+    if (rank(&p, &heap[0], goal) >= 0) return;
+
+    // Replace the worst entry and sift it down past worse children
+    for (i = 0;;) {
+        size_t c = 2 * i + 1;
+        if (c >= cap) break;
+        if (c + 1 < cap && rank(&heap[c + 1], &heap[c], goal) > 0) c++;
+        if (rank(&heap[c], &p, goal) <= 0) break;
+        heap[i] = heap[c];
+        i = c;
+    }
+    heap[i] = p;
+}
+
+/**
+ * @fn fresh_cell
+ * @brief Checks whether an antinode would be a new danger cell of the frequency.
+ * @param job Pointer to the job.
+ * @param row Row of the antinode.
+ * @param col Column of the antinode.
+ * @return True if the cell is inside the map and not yet dangerous for the frequency.
+ */
+static inline bool fresh_cell(const PlacementJob *job, int64_t row, int64_t col) {
+    if (row < 0 || row >= job->g->rows || col < 0 || col >= job->g->cols) return false;
+    return !(job->own && bitgrid_test(job->own, row, col));
+}
+
+/**
+ * @fn is_site
+ * @brief Checks whether a cell holds an antenna of the frequency.
+ * @param job Pointer to the job.
+ * @param row Row of the cell.
+ * @param col Column of the cell.
+ * @return True if the cell holds such an antenna, false otherwise.
+ */
+static inline bool is_site(const PlacementJob *job, int64_t row, int64_t col) {
+    if (row < INT32_MIN || row > INT32_MAX || col < INT32_MIN || col > INT32_MAX) return false;
+    return coord_set_contains(job->mine, (Coord) {.row = (int32_t) row, .col = (int32_t) col});
+}
+
+/**
+ * @fn score
+ * @brief Counts the danger that a new antenna on a cell would add.
+ * @param job Pointer to the job.
+ * @param row Row of the candidate.
+ * @param col Column of the candidate.
+ * @return The scored placement.
+ */
+static Placement score(const PlacementJob *job, int32_t row, int32_t col) {
+    Placement p = {.cell = {.row = row, .col = col}};
+    for (size_t i = 0; i < job->k; ++i) {
+        int64_t dr = (int64_t) row - job->site[i].row;
+        int64_t dc = (int64_t) col - job->site[i].col;
+
+        // Beyond the candidate: 2p - b
+        int64_t r = (int64_t) row + dr, c = (int64_t) col + dc;
+        if (fresh_cell(job, r, c)) {
+            p.new_cells++;
+            p.new_overlaps += bitgrid_test(job->any, r, c);
+        }
+        // Beyond the antenna: 2b - p, unless it is 2p - b' for b' = 3p - 2b
+        r = (int64_t) job->site[i].row - dr;
+        c = (int64_t) job->site[i].col - dc;
+        if (fresh_cell(job, r, c) && !is_site(job, (int64_t) row + 2 * dr, (int64_t) col + 2 * dc)) {
+            p.new_cells++;
+            p.new_overlaps += bitgrid_test(job->any, r, c);
+        }
+    }
+    return p;
+}
+
+/**
+ * @fn placement_task
+ * @brief Scores the candidates of one row of the area.
+ * @param task Row of the area.
+ * @param worker Worker index.
+ * @param ctx Pointer to the PlacementJob.
+ * @return Always STATUS_OK.
+ */
+static Status placement_task(size_t task, size_t worker, void *ctx) {
+    PlacementJob *job = ctx;
+    int32_t row = job->area.row0 + (int32_t) task;
+    Placement *heap = job->heap + worker * job->n_best;
+    for (int32_t col = job->area.col0; col < job->area.col0 + job->area.cols; ++col) {
+        if (coord_set_contains(job->taken, (Coord) {.row = row, .col = col})) continue;
+        heap_offer(heap, &job->size[worker], job->n_best, score(job, row, col), job->goal);
+    }
+    return STATUS_OK;
+}
+
+/**
+ * @fn graph_best_placements
+ * @brief Finds the best free cells for a new antenna of a given frequency.
+ * @param g Pointer to the graph.
+ * @param freq Frequency of the new antenna.
+ * @param region Optional block of candidate cells, NULL for the whole map.
+ * @param goal Count to minimise first.
+ * @param n_best Number of placements wanted.
+ * @param n_workers Number of worker threads (0 for one per processor).
+ * @param out Output array of n_best placements.
+ * @param count Pointer to store the number of placements written.
+ * @return Status indicating success or failure.
+ */
+Status graph_best_placements(const Graph *g, char freq, const Region *region, PlacementGoal goal,
+                             size_t n_best, size_t n_workers, Placement *out, size_t *count) {
+    if (!g || !out || !count || n_best == 0) return STATUS_INVALID;
+    if (goal != PLACE_FEWEST_CELLS && goal != PLACE_FEWEST_OVERLAPS) return STATUS_INVALID;
+    *count = 0;
+
+    // Clip the candidate block to the map
+    int64_t r0 = 0, c0 = 0, r1 = g->rows, c1 = g->cols;
+    if (region) {
+        if (region->row0 > r0) r0 = region->row0;
+        if (region->col0 > c0) c0 = region->col0;
+        if ((int64_t) region->row0 + region->rows < r1) r1 = (int64_t) region->row0 + region->rows;
+        if ((int64_t) region->col0 + region->cols < c1) c1 = (int64_t) region->col0 + region->cols;
+    }
+    if (r1 <= r0 || c1 <= c0) return STATUS_OK;
+    Region area = {.row0 = (int32_t) r0, .col0 = (int32_t) c0, .rows = (int32_t) (r1 - r0), .cols = (int32_t) (c1 - c0)};
+    size_t cells = (size_t) area.rows * (size_t) area.cols;
+    if (n_best > cells) n_best = cells;
+
+    DangerMap danger;
+    Status st = graph_danger_all(g, n_workers, &danger);
+    if (st != STATUS_OK) return st;
+
+    CoordSet mine, taken;
+    size_t workers = parallel_worker_count(n_workers, (size_t) area.rows);
+    Coord *site = malloc((g->n ? g->n : 1) * sizeof(Coord));
+    Placement *heap = malloc(workers * n_best * sizeof(Placement));
+    size_t *size = calloc(workers, sizeof(size_t));
+    bool sets = coord_set_init(&mine, 0) == STATUS_OK;
+    if (sets && coord_set_init(&taken, g->n) != STATUS_OK) {
+        coord_set_free(&mine);
+        sets = false;
+    }
+    if (!site || !heap || !size || !sets) {
+        st = STATUS_ALLOC;
+        goto done;
+    }
+
+    // Stacked antennas of the frequency add the same antinodes once
+    size_t k = 0;
+    for (size_t i = 0; i < g->n && st == STATUS_OK; ++i) {
+        Coord c = {.row = g->v[i].row, .col = g->v[i].col};
+        st = coord_set_insert(&taken, c, NULL);
+        if (st != STATUS_OK || g->v[i].freq != freq) continue;
+        bool inserted;
+        st = coord_set_insert(&mine, c, &inserted);
+        if (st == STATUS_OK && inserted) site[k++] = c;
+    }
+
+    if (st == STATUS_OK) {
+        PlacementJob job = {
+                .g = g, .area = area, .goal = goal, .site = site, .k = k,
+                .mine = &mine, .taken = &taken, .own = danger_map_find(&danger, freq), .any = &danger.all,
+                .n_best = n_best, .heap = heap, .size = size
+        };
+        st = parallel_for((size_t) area.rows, workers, placement_task, &job);
+    }
+
+    if (st == STATUS_OK) {
+        // Merge the worker heaps: pack them, sort, keep the best
+        size_t total = 0;
+        for (size_t w = 0; w < workers; ++w) {
+            for (size_t i = 0; i < size[w]; ++i) heap[total++] = heap[w * n_best + i];
+        }
+        qsort(heap, total, sizeof(Placement), goal == PLACE_FEWEST_OVERLAPS ? by_overlaps : by_cells);
+        *count = total < n_best ? total : n_best;
+        for (size_t i = 0; i < *count; ++i) out[i] = heap[i];
+    }
+
+    done:
+    if (sets) {
+        coord_set_free(&mine);
+        coord_set_free(&taken);
+    }
+    free(site);
+    free(heap);
+    free(size);
+    danger_map_free(&danger);
+    return st;
+}
+
+/**
+ * @struct Chain
+ *
+ * @brief State of one annealing chain.
+ */
+typedef struct {
+    uint8_t *freq;       /* frequency slot of each antenna      */
+    size_t *head;        /* first antenna of each slot, SIZE_MAX for none */
+    size_t *prev;        /* previous antenna in the same slot   */
+    size_t *next;        /* next antenna in the same slot       */
+    CoordSet *count;     /* pairs per cell, one set per slot    */
+    CoordSet hot;        /* slots with a non-zero count, per cell */
+    size_t any;          /* cells with at least one slot        */
+    size_t overlap;      /* cells with two slots or more        */
+} Chain;
+
+/**
+ * @struct ReassignJob
+ *
+ * @brief Shared state of one graph_reassign_freqs() call.
+ */
+typedef struct {
+    const Graph *g;
+    ReassignGoal goal;
+    size_t steps;
+    double t_start;
+    double t_end;
+    uint64_t seed;
+    size_t n_slots;      /* frequencies an antenna may take     */
+    const uint8_t *start; /* initial slot of each antenna       */
+    uint8_t *best;       /* best assignment of each chain       */
+    size_t *best_score;  /* its goal value                      */
+    size_t before;       /* goal value of the initial assignment */
+} ReassignJob;
+
+/**
+ * @fn next_random
+ * @brief Advances a splitmix64 generator.
+ * @param state Pointer to the generator state.
+ * @return The next 64-bit random value.
+ */
+static inline uint64_t next_random(uint64_t *state) {
+    uint64_t z = (*state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @fn unit_random
+ * @brief Draws a uniform double in [0, 1).
+ * @param state Pointer to the generator state.
+ * @return The random value.
+ */
+static inline double unit_random(uint64_t *state) {
+    return (double) (next_random(state) >> 11) * 0x1.0p-53;
+}
+
+/**
+ * @fn bump
+ * @brief Adds or withdraws one pair of a slot on a cell.
+ * @param c Pointer to the chain.
+ * @param count Pair counts of the slot.
+ * @param cell Cell of the antinode.
+ * @param add True to add the pair, false to withdraw it.
+ * @return Status indicating success or failure.
+ */
+static Status bump(Chain *c, CoordSet *count, Coord cell, bool add) {
+    bool changed;
+    Status st;
+    if (add) {
+        st = coord_set_insert(count, cell, &changed);
+        if (st != STATUS_OK || !changed) return st;
+        // First pair of the slot on the cell
+        if ((st = coord_set_insert(&c->hot, cell, &changed)) != STATUS_OK) return st;
+        if (changed) c->any++;
+        else if (coord_set_hits(&c->hot, cell) == 2) c->overlap++;
+        return STATUS_OK;
+    }
+    st = coord_set_release(count, cell, &changed);
+    if (st != STATUS_OK || !changed) return st;
+    // Last pair of the slot left the cell
+    if (coord_set_hits(&c->hot, cell) == 2) c->overlap--;
+    if ((st = coord_set_release(&c->hot, cell, &changed)) != STATUS_OK) return st;
+    if (changed) c->any--;
+    return STATUS_OK;
+}
+
+/**
+ * @fn chain_pairs
+ * @brief Adds or withdraws the pairs an antenna forms with the antennas of a slot.
+ * @param job Pointer to the job.
+ * @param c Pointer to the chain.
+ * @param i Antenna index.
+ * @param slot Frequency slot.
+ * @param add True to add the pairs, false to withdraw them.
+ * @return Status indicating success or failure.
+ */
+static Status chain_pairs(const ReassignJob *job, Chain *c, size_t i, uint8_t slot, bool add) {
+    const Graph *g = job->g;
+    const Vertex *a = &g->v[i];
+    CoordSet *count = &c->count[slot];
+    Status st = STATUS_OK;
+    for (size_t m = c->head[slot]; m != SIZE_MAX && st == STATUS_OK; m = c->next[m]) {
+        const Vertex *b = &g->v[m];
+        int64_t dr = (int64_t) b->row - a->row;
+        int64_t dc = (int64_t) b->col - a->col;
+        if (dr == 0 && dc == 0) continue; // skip same point
+
+        int64_t node[2][2] = {{a->row - dr, a->col - dc}, {b->row + dr, b->col + dc}};
+        for (size_t t = 0; t < 2 && st == STATUS_OK; ++t) {
+            int64_t row = node[t][0], col = node[t][1];
+            if (row < 0 || row >= g->rows || col < 0 || col >= g->cols) continue;
+            st = bump(c, count, (Coord) {.row = (int32_t) row, .col = (int32_t) col}, add);
+        }
+    }
+    return st;
+}
+
+/**
+ * @fn chain_join
+ * @brief Tunes an antenna that is in no slot to a slot.
+ * @param job Pointer to the job.
+ * @param c Pointer to the chain.
+ * @param i Antenna index.
+ * @param slot Frequency slot.
+ * @return Status indicating success or failure.
+ */
+static Status chain_join(const ReassignJob *job, Chain *c, size_t i, uint8_t slot) {
+    Status st = chain_pairs(job, c, i, slot, true);
+    // Link at the head of the slot list
+    c->prev[i] = SIZE_MAX;
+    c->next[i] = c->head[slot];
+    if (c->head[slot] != SIZE_MAX) c->prev[c->head[slot]] = i;
+    c->head[slot] = i;
+    c->freq[i] = slot;
+    return st;
+}
+
+/**
+ * @fn chain_leave
+ * @brief Takes an antenna out of its slot.
+ * @param job Pointer to the job.
+ * @param c Pointer to the chain.
+ * @param i Antenna index.
+ * @return Status indicating success or failure.
+ */
+static Status chain_leave(const ReassignJob *job, Chain *c, size_t i) {
+    uint8_t slot = c->freq[i];
+    // Unlink from the slot list
+    if (c->prev[i] != SIZE_MAX) c->next[c->prev[i]] = c->next[i];
+    else c->head[slot] = c->next[i];
+    if (c->next[i] != SIZE_MAX) c->prev[c->next[i]] = c->prev[i];
+    return chain_pairs(job, c, i, slot, false);
+}
+
+/**
+ * @fn chain_score
+ * @brief Returns the goal value of the current assignment of a chain.
+ * @param job Pointer to the job.
+ * @param c Pointer to the chain.
+ * @return The goal value.
+ */
+static inline size_t chain_score(const ReassignJob *job, const Chain *c) {
+    return job->goal == REASSIGN_OVERLAPS ? c->overlap : c->any;
+}
+
+/**
+ * @fn anneal_task
+ * @brief Runs one annealing chain.
+ * @param task Chain number.
+ * @param worker Worker index (unused).
+ * @param ctx Pointer to the ReassignJob.
+ * @return Status indicating success or failure.
+ */
+static Status anneal_task(size_t task, size_t worker, void *ctx) {
+    (void) worker;
+    ReassignJob *job = ctx;
+    size_t n = job->g->n;
+    Chain c = {0};
+    c.freq = malloc(n * sizeof(uint8_t));
+    c.head = malloc(job->n_slots * sizeof(size_t));
+    c.prev = malloc(n * sizeof(size_t));
+    c.next = malloc(n * sizeof(size_t));
+    c.count = calloc(job->n_slots, sizeof(CoordSet));
+    Status st = STATUS_OK;
+    if (!c.freq || !c.head || !c.prev || !c.next || !c.count) {
+        st = STATUS_ALLOC;
+        goto done;
+    }
+    for (size_t f = 0; f < job->n_slots; ++f) c.head[f] = SIZE_MAX;
+    for (size_t f = 0; f < job->n_slots && st == STATUS_OK; ++f) st = coord_set_init(&c.count[f], 0);
+    if (st == STATUS_OK) st = coord_set_init(&c.hot, 0);
+    for (size_t i = 0; i < n && st == STATUS_OK; ++i) st = chain_join(job, &c, i, job->start[i]);
+    if (st != STATUS_OK) goto done;
+
+    size_t score = chain_score(job, &c);
+    uint8_t *best = job->best + task * n;
+    memcpy(best, c.freq, n);
+    job->best_score[task] = score;
+    if (task == 0) job->before = score;
+
+    uint64_t rng = job->seed + task * 0xd1b54a32d192ed03ULL;
+    double t = job->t_start;
+    double cool = job->steps ? pow(job->t_end / job->t_start, 1.0 / (double) job->steps) : 1.0;
+    for (size_t s = 0; s < job->steps && st == STATUS_OK; ++s, t *= cool) {
+        size_t i = (size_t) (next_random(&rng) % n);
+        uint8_t from = c.freq[i];
+        uint8_t to = (uint8_t) (next_random(&rng) % (job->n_slots - 1));
+        if (to >= from) to++;
+
+        if ((st = chain_leave(job, &c, i)) != STATUS_OK || (st = chain_join(job, &c, i, to)) != STATUS_OK) break;
+        size_t moved = chain_score(job, &c);
+        if (moved <= score || unit_random(&rng) < exp(-((double) moved - (double) score) / t)) {
+            score = moved;
+            if (score < job->best_score[task]) {
+                job->best_score[task] = score;
+                memcpy(best, c.freq, n);
+            }
+        } else if ((st = chain_leave(job, &c, i)) == STATUS_OK) {
+            st = chain_join(job, &c, i, from);
+        }
+    }
+
+    done:
+    free(c.freq);
+    free(c.head);
+    free(c.prev);
+    free(c.next);
+    for (size_t f = 0; c.count && f < job->n_slots; ++f) coord_set_free(&c.count[f]);
+    free(c.count);
+    coord_set_free(&c.hot);
+    return st;
+}
+
+/**
+ * @fn graph_reassign_freqs
+ * @brief Retunes antennas to minimise the danger cells or the overlaps of the map.
+ * @param g Pointer to the graph.
+ * @param params Settings, NULL for the defaults.
+ * @param n_workers Number of worker threads (0 for one per processor).
+ * @param out Optional pointer to the result.
+ * @return Status indicating success or failure.
+ */
+Status graph_reassign_freqs(Graph *g, const ReassignParams *params, size_t n_workers, ReassignResult *out) {
+    ReassignParams p = params ? *params : (ReassignParams) {0};
+    if (!g || (p.n_freqs && !p.freqs)) return STATUS_INVALID;
+    if (p.goal != REASSIGN_DANGER_CELLS && p.goal != REASSIGN_OVERLAPS) return STATUS_INVALID;
+    if (p.t_start < 0 || p.t_end < 0) return STATUS_INVALID;
+    if (out) *out = (ReassignResult) {0};
+    if (g->n == 0) return STATUS_OK;
+
+    // Number the frequencies an antenna may take
+    int slot_of[FREQ_SLOTS];
+    char freq[FREQ_SLOTS];
+    size_t n_slots = 0;
+    for (size_t f = 0; f < FREQ_SLOTS; ++f) slot_of[f] = -1;
+    for (size_t i = 0; i < g->n + p.n_freqs; ++i) {
+        unsigned char f = (unsigned char) (i < g->n ? g->v[i].freq : p.freqs[i - g->n]);
+        if (slot_of[f] < 0) {
+            slot_of[f] = (int) n_slots;
+            freq[n_slots++] = (char) f;
+        }
+    }
+
+    ReassignJob job = {
+            .g = g, .goal = p.goal,
+            .steps = p.steps ? p.steps : REASSIGN_STEPS,
+            .t_start = p.t_start > 0 ? p.t_start : REASSIGN_T_START,
+            .t_end = p.t_end > 0 ? p.t_end : REASSIGN_T_END,
+            .seed = p.seed, .n_slots = n_slots
+    };
+    // With a single frequency there is nothing to move to
+    if (n_slots < 2) job.steps = 0;
+    size_t chains = p.chains ? p.chains : parallel_worker_count(n_workers, SIZE_MAX);
+
+    uint8_t *start = malloc(g->n * sizeof(uint8_t));
+    job.best = malloc(chains * g->n * sizeof(uint8_t));
+    job.best_score = malloc(chains * sizeof(size_t));
+    Status st = STATUS_OK;
+    if (!start || !job.best || !job.best_score) {
+        st = STATUS_ALLOC;
+        goto done;
+    }
+    for (size_t i = 0; i < g->n; ++i) start[i] = (uint8_t) slot_of[(unsigned char) g->v[i].freq];
+    job.start = start;
+
+    st = parallel_for(chains, n_workers, anneal_task, &job);
+    if (st != STATUS_OK) goto done;
+
+    // Ties go to the lowest chain, so the result only depends on the seed
+    size_t win = 0;
+    for (size_t t = 1; t < chains; ++t) if (job.best_score[t] < job.best_score[win]) win = t;
+
+    const uint8_t *best = job.best + win * g->n;
+    size_t changed = 0;
+    for (size_t i = 0; i < g->n && st == STATUS_OK; ++i) {
+        if (best[i] == start[i]) continue;
+        st = graph_retune_vertex(g, i, freq[best[i]]);
+        changed++;
+    }
+    if (out && st == STATUS_OK) *out = (ReassignResult) {.before = job.before, .after = job.best_score[win], .changed = changed};
+
+    done:
+    free(start);
+    free(job.best);
+    free(job.best_score);
+    return st;
+}
@@ -0,0 +1,264 @@
+/**
+ * @file proximity.c
+ * @brief Implementation of the proximity graph builder.
+ *
+ * Vertices are sorted by bucket, and the non-empty buckets are listed in
+ * (bucket row, bucket column) order, so the neighbouring buckets of any
+ * bucket are found by binary search. Each bucket row is one task; every
+ * task only writes the degree and the neighbour list of its own vertices.
+ *
+ * @author Ahmet Abdullah GULTEKIN
+ * @date 2025-05-25
+ *
+ * @see proximity.h for the header file containing the function prototypes
+ * and data structures.
+ */
+
+#include <stdlib.h>     /* malloc, calloc, qsort, free */
+#include <math.h>       /* ceil, isnan */
+#include "../include/proximity.h"
+#include "../include/parallel.h"
+
+/**
+ * Bucket side used when the radius covers every possible coordinate.
+ */
+#define PROXIMITY_MAX_CELL ((int64_t) 1 << 33)
+
+/**
+ * @struct Bucket
+ *
+ * @brief One non-empty cell of the bucketing grid.
+ */
+typedef struct {
+    int64_t row;         /* bucket row                          */
+    int64_t col;         /* bucket column                       */
+    size_t start;        /* first vertex in ProximityJob::order */
+    size_t end;          /* one past the last vertex            */
+} Bucket;
+
+/**
+ * @struct Keyed
+ *
+ * @brief A vertex together with its bucket, for sorting.
+ */
+typedef struct {
+    int64_t row;
+    int64_t col;
+    size_t v;
+} Keyed;
+
+/**
+ * @struct ProximityJob
+ *
+ * @brief Shared state of one graph_proximity() call.
+ */
+typedef struct {
+    const Graph *g;
+    double radius;
+    Metric metric;
+    size_t *order;       /* vertices sorted by bucket           */
+    Bucket *bucket;      /* non-empty buckets, sorted           */
+    size_t n_buckets;
+    size_t *row_start;   /* first bucket of each bucket row     */
+    size_t *deg;         /* neighbour count of each vertex      */
+    CsrGraph *out;       /* NULL during the counting pass       */
+} ProximityJob;
+
+/**
+ * @fn by_bucket
+ * @brief Orders keyed vertices by bucket row, bucket column, then index.
+ * @param a Pointer to the first Keyed.
+ * @param b Pointer to the second Keyed.
+ * @return Negative, zero or positive as for qsort.
+ */
+static int by_bucket(const void *a, const void *b) {
+    const Keyed *x = a, *y = b;
+    if (x->row != y->row) return x->row < y->row ? -1 : 1;
+    if (x->col != y->col) return x->col < y->col ? -1 : 1;
+    return (x->v > y->v) - (x->v < y->v);
+}
+
+/**
+ * @fn by_index
+ * @brief Orders vertex indices increasingly.
+ * @param a Pointer to the first index.
+ * @param b Pointer to the second index.
+ * @return Negative, zero or positive as for qsort.
+ */
+static int by_index(const void *a, const void *b) {
+    size_t x = *(const size_t *) a, y = *(const size_t *) b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @fn find_bucket
+ * @brief Finds a non-empty bucket by binary search.
+ * @param job Pointer to the job.
+ * @param row Bucket row.
+ * @param col Bucket column.
+ * @return Pointer to the bucket, or NULL if it is empty.
+ */
+static const Bucket *find_bucket(const ProximityJob *job, int64_t row, int64_t col) {
+    size_t lo = 0, hi = job->n_buckets;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        const Bucket *b = &job->bucket[mid];
+        if (b->row < row || (b->row == row && b->col < col)) lo = mid + 1;
+        else hi = mid;
+    }
+    if (lo < job->n_buckets && job->bucket[lo].row == row && job->bucket[lo].col == col) return &job->bucket[lo];
+    return NULL;
+}
+
+/**
+ * @fn within
+ * @brief Checks whether two vertices are at most the radius apart.
+ * @param job Pointer to the job.
+ * @param a First vertex.
+ * @param b Second vertex.
+ * @return True if the vertices are close enough, false otherwise.
+ */
+static inline bool within(const ProximityJob *job, const Vertex *a, const Vertex *b) {
+    double dr = (double) a->row - b->row;
+    double dc = (double) a->col - b->col;
+    if (job->metric == METRIC_MANHATTAN) return fabs(dr) + fabs(dc) <= job->radius;
+    return dr * dr + dc * dc <= job->radius * job->radius;
+}
+
+/**
+ * @fn proximity_task
+ * @brief Counts or fills the neighbours of the vertices of one bucket row.
+ * @param task Bucket row number.
+ * @param worker Worker index (unused).
+ * @param ctx Pointer to the ProximityJob.
+ * @return Always STATUS_OK.
+ */
+static Status proximity_task(size_t task, size_t worker, void *ctx) {
+    (void) worker;
+    ProximityJob *job = ctx;
+    const Vertex *v = job->g->v;
+
+    for (size_t b = job->row_start[task]; b < job->row_start[task + 1]; ++b) {
+        const Bucket *home = &job->bucket[b];
+        // The buckets of the 3x3 block, looked up once for all vertices of home
+        const Bucket *near[9];
+        size_t n_near = 0;
+        for (int64_t dr = -1; dr <= 1; ++dr) {
+            for (int64_t dc = -1; dc <= 1; ++dc) {
+                const Bucket *nb = (dr == 0 && dc == 0) ? home : find_bucket(job, home->row + dr, home->col + dc);
+                if (nb) near[n_near++] = nb;
+            }
+        }
+
+        for (size_t i = home->start; i < home->end; ++i) {
+            size_t a = job->order[i];
+            size_t k = 0;
+            size_t *list = job->out ? job->out->adj + job->out->offset[a] : NULL;
+            for (size_t nb = 0; nb < n_near; ++nb) {
+                for (size_t j = near[nb]->start; j < near[nb]->end; ++j) {
+                    size_t c = job->order[j];
+                    if (c == a || !within(job, &v[a], &v[c])) continue;
+                    if (list) list[k] = c;
+                    k++;
+                }
+            }
+            if (list) qsort(list, k, sizeof(size_t), by_index);
+            else job->deg[a] = k;
+        }
+    }
+    return STATUS_OK;
+}
+
+/**
+ * @fn graph_proximity
+ * @brief Builds the graph linking every pair of antennas at most radius apart.
+ * @param g Pointer to the graph.
+ * @param radius Largest distance of a proximity edge.
+ * @param metric Distance used to compare with the radius.
+ * @param n_workers Number of worker threads (0 for one per processor).
+ * @param out Pointer to the output CsrGraph.
+ * @return Status indicating success or failure.
+ */
+Status graph_proximity(const Graph *g, double radius, Metric metric, size_t n_workers, CsrGraph *out) {
+    if (!g || !out || isnan(radius) || radius < 0) return STATUS_INVALID;
+    if (metric != METRIC_EUCLIDEAN && metric != METRIC_MANHATTAN) return STATUS_INVALID;
+    out->n = g->n;
+    out->adj = NULL;
+    out->offset = calloc(g->n + 1, sizeof(size_t));
+    if (!out->offset) return STATUS_ALLOC;
+    if (g->n == 0) return STATUS_OK;
+
+    // Any pair within the radius lies in the same or in adjacent cells
+    int64_t cell = radius >= (double) PROXIMITY_MAX_CELL ? PROXIMITY_MAX_CELL : (int64_t) ceil(radius);
+    if (cell < 1) cell = 1;
+
+    ProximityJob job = {.g = g, .radius = radius, .metric = metric, .out = NULL};
+    Keyed *keyed = malloc(g->n * sizeof(Keyed));
+    job.order = malloc(g->n * sizeof(size_t));
+    job.bucket = malloc(g->n * sizeof(Bucket));
+    job.row_start = malloc((g->n + 1) * sizeof(size_t));
+    job.deg = malloc(g->n * sizeof(size_t));
+    Status st = STATUS_OK;
+    if (!keyed || !job.order || !job.bucket || !job.row_start || !job.deg) {
+        st = STATUS_ALLOC;
+        goto done;
+    }
+
+    // Floor division keeps negative coordinates in the right cell
+    for (size_t i = 0; i < g->n; ++i) {
+        int64_t r = g->v[i].row, c = g->v[i].col;
+        keyed[i] = (Keyed) {
+                .row = r >= 0 ? r / cell : -((-r + cell - 1) / cell),
+                .col = c >= 0 ? c / cell : -((-c + cell - 1) / cell),
+                .v = i
+        };
+    }
+    qsort(keyed, g->n, sizeof(Keyed), by_bucket);
+
+    size_t n_rows = 0;
+    for (size_t i = 0; i < g->n; ++i) {
+        job.order[i] = keyed[i].v;
+        bool new_bucket = i == 0 || keyed[i].row != keyed[i - 1].row || keyed[i].col != keyed[i - 1].col;
+        if (new_bucket) {
+            if (i == 0 || keyed[i].row != keyed[i - 1].row) job.row_start[n_rows++] = job.n_buckets;
+            job.bucket[job.n_buckets++] = (Bucket) {.row = keyed[i].row, .col = keyed[i].col, .start = i, .end = i};
+        }
+        job.bucket[job.n_buckets - 1].end = i + 1;
+    }
+    job.row_start[n_rows] = job.n_buckets;
+
+    st = parallel_for(n_rows, n_workers, proximity_task, &job);
+    if (st != STATUS_OK) goto done;
+
+    for (size_t i = 0; i < g->n; ++i) out->offset[i + 1] = out->offset[i] + job.deg[i];
+    out->adj = malloc((out->offset[g->n] ? out->offset[g->n] : 1) * sizeof(size_t));
+    if (!out->adj) {
+        st = STATUS_ALLOC;
+        goto done;
+    }
+    job.out = out;
+    st = parallel_for(n_rows, n_workers, proximity_task, &job);
+
+    done:
+    free(keyed);
+    free(job.order);
+    free(job.bucket);
+    free(job.row_start);
+    free(job.deg);
+    if (st != STATUS_OK) csr_graph_free(out);
+    return st;
+}
+
+/**
+ * @fn csr_graph_free
+ * @brief Frees the resources of a CsrGraph.
+ * @param c Pointer to the CsrGraph.
+ */
+void csr_graph_free(CsrGraph *c) {
+    if (!c) return;
+    free(c->offset);
+    free(c->adj);
+    c->offset = NULL;
+    c->adj = NULL;
+    c->n = 0;
+}
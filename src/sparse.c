@@ -0,0 +1,546 @@
+/**
+ * @file sparse.c
+ * @brief Implementation of the sparse 64-bit coordinate mode.
+ *
+ * Occupancy is an open-addressing hash set of (row, col) pairs, and danger
+ * cells are collected per frequency into arrays that are sorted and
+ * deduplicated, then merged. Nothing is sized by the map extent.
+ *
+ * @author Ahmet Abdullah GULTEKIN
+ * @date 2025-05-25
+ *
+ * @see sparse.h for the header file containing the function prototypes.
+ */
+
+#include <stdio.h>      /* FILE, fopen, fclose */
+#include <stdlib.h>     /* malloc, calloc, realloc, free, qsort, strtoll */
+#include <string.h>     /* memset, memcpy, strncmp */
+#include <ctype.h>      /* isprint, isspace */
+#include <errno.h>      /* errno, ERANGE */
+#include "../include/sparse.h"
+#include "../include/parallel.h"
+
+/**
+ * @fn sparse_slot
+ * @brief Returns the slot holding a cell, or the empty slot where it would go.
+ * @param s Pointer to the set.
+ * @param c Cell to look up.
+ * @return The slot index.
+ */
+static size_t sparse_slot(const SparseSet *s, SparseCoord c) {
+    size_t mask = s->cap - 1;
+    size_t i = (size_t) mix64((uint64_t) c.row ^ mix64((uint64_t) c.col)) & mask;
+    while (s->used[i] && (s->keys[i].row != c.row || s->keys[i].col != c.col)) i = (i + 1) & mask;
+    return i;
+}
+
+/**
+ * @fn sparse_set_alloc
+ * @brief Allocates an empty set with the given number of slots.
+ * @param s Pointer to the set.
+ * @param cap Slot count (power of two).
+ * @return Status indicating success or failure.
+ */
+static Status sparse_set_alloc(SparseSet *s, size_t cap) {
+    s->keys = malloc(cap * sizeof(SparseCoord));
+    s->used = calloc(cap, sizeof(uint8_t));
+    if (!s->keys || !s->used) {
+        free(s->keys);
+        free(s->used);
+        s->keys = NULL;
+        s->used = NULL;
+        return STATUS_ALLOC;
+    }
+    s->cap = cap;
+    s->count = 0;
+    return STATUS_OK;
+}
+
+/**
+ * @fn sparse_set_insert
+ * @brief Inserts a cell, doubling the table when it gets half full.
+ * @param s Pointer to the set.
+ * @param c Cell to insert.
+ * @return Status indicating success or failure.
+ */
+static Status sparse_set_insert(SparseSet *s, SparseCoord c) {
+    if ((s->count + 1) * 2 > s->cap) {
+        if (s->cap > SIZE_MAX / 2) return STATUS_OVERFLOW;
+        SparseSet bigger;
+        Status st = sparse_set_alloc(&bigger, s->cap * 2);
+        if (st != STATUS_OK) return st;
+        for (size_t i = 0; i < s->cap; ++i) {
+            if (!s->used[i]) continue;
+            size_t j = sparse_slot(&bigger, s->keys[i]);
+            bigger.used[j] = 1;
+            bigger.keys[j] = s->keys[i];
+            bigger.count++;
+        }
+        free(s->keys);
+        free(s->used);
+        *s = bigger;
+    }
+
+    size_t i = sparse_slot(s, c);
+    if (s->used[i]) return STATUS_OK;
+    s->used[i] = 1;
+    s->keys[i] = c;
+    s->count++;
+    return STATUS_OK;
+}
+
+/**
+ * @fn in_limit
+ * @brief Checks that a coordinate is within SPARSE_COORD_LIMIT.
+ * @param x Coordinate.
+ * @return True if the coordinate is allowed.
+ */
+static inline bool in_limit(int64_t x) {
+    return x >= -SPARSE_COORD_LIMIT && x <= SPARSE_COORD_LIMIT;
+}
+
+/**
+ * @fn in_extent
+ * @brief Checks whether a cell lies inside the extent of the graph.
+ * @param g Pointer to the graph.
+ * @param row Row of the cell.
+ * @param col Column of the cell.
+ * @return True if the cell is inside the extent.
+ */
+static inline bool in_extent(const SparseGraph *g, int64_t row, int64_t col) {
+    // Compare against the last row and column: row - row0 could overflow for far antinodes
+    return row >= g->row0 && row <= g->row0 + (g->rows - 1) && col >= g->col0 && col <= g->col0 + (g->cols - 1);
+}
+
+/**
+ * @fn sparse_graph_init
+ * @brief Initializes an empty sparse graph.
+ * @param g Pointer to the graph.
+ * @return Status indicating success or failure.
+ */
+Status sparse_graph_init(SparseGraph *g) {
+    if (!g) return STATUS_INVALID;
+    memset(g, 0, sizeof(*g));
+    return sparse_set_alloc(&g->occupied, 16);
+}
+
+/**
+ * @fn sparse_graph_set_extent
+ * @brief Sets the extent of the map.
+ * @param g Pointer to the graph.
+ * @param row0 Top row.
+ * @param col0 Left column.
+ * @param rows Extent height.
+ * @param cols Extent width.
+ * @return Status indicating success or failure.
+ */
+Status sparse_graph_set_extent(SparseGraph *g, int64_t row0, int64_t col0, int64_t rows, int64_t cols) {
+    if (!g || rows < 1 || cols < 1) return STATUS_INVALID;
+    if (!in_limit(row0) || !in_limit(col0) || rows > SPARSE_COORD_LIMIT - row0 + 1 ||
+        cols > SPARSE_COORD_LIMIT - col0 + 1)
+        return STATUS_OVERFLOW;
+
+    SparseGraph next = *g;
+    next.row0 = row0;
+    next.col0 = col0;
+    next.rows = rows;
+    next.cols = cols;
+    for (size_t i = 0; i < g->n; ++i) {
+        if (!in_extent(&next, g->v[i].row, g->v[i].col)) return STATUS_INVALID;
+    }
+    next.fixed = true;
+    *g = next;
+    return STATUS_OK;
+}
+
+/**
+ * @fn sparse_graph_insert
+ * @brief Adds an antenna to a sparse graph.
+ * @param g Pointer to the graph.
+ * @param freq Frequency of the antenna.
+ * @param row Row of the antenna.
+ * @param col Column of the antenna.
+ * @return Status indicating success or failure.
+ */
+Status sparse_graph_insert(SparseGraph *g, char freq, int64_t row, int64_t col) {
+    if (!g || !g->occupied.keys) return STATUS_INVALID;
+    if (!in_limit(row) || !in_limit(col)) return STATUS_OVERFLOW;
+    if (g->fixed && !in_extent(g, row, col)) return STATUS_INVALID;
+
+    if (g->n == g->cap) {
+        size_t cap = g->cap ? g->cap * 2 : 16;
+        SparseAntenna *v = realloc(g->v, cap * sizeof(SparseAntenna));
+        if (!v) return STATUS_ALLOC;
+        g->v = v;
+        g->cap = cap;
+    }
+    Status st = sparse_set_insert(&g->occupied, (SparseCoord) {.row = row, .col = col});
+    if (st != STATUS_OK) return st;
+    g->v[g->n++] = (SparseAntenna) {.freq = freq, .row = row, .col = col};
+
+    // Grow the bounding box
+    if (g->fixed) return STATUS_OK;
+    if (g->n == 1) {
+        g->row0 = row;
+        g->col0 = col;
+        g->rows = 1;
+        g->cols = 1;
+        return STATUS_OK;
+    }
+    if (row < g->row0) {
+        g->rows += g->row0 - row;
+        g->row0 = row;
+    } else if (row > g->row0 + (g->rows - 1)) {
+        g->rows = row - g->row0 + 1;
+    }
+    if (col < g->col0) {
+        g->cols += g->col0 - col;
+        g->col0 = col;
+    } else if (col > g->col0 + (g->cols - 1)) {
+        g->cols = col - g->col0 + 1;
+    }
+    return STATUS_OK;
+}
+
+/**
+ * @fn parse_int64
+ * @brief Parses the next integer field of a line.
+ * @param p Pointer to the parse position, advanced past the field.
+ * @param out Pointer to store the value.
+ * @return Status indicating success or failure.
+ */
+static Status parse_int64(const char **p, int64_t *out) {
+    while (**p == ' ' || **p == '\t' || **p == ',') (*p)++;
+    char *end;
+    errno = 0;
+    long long v = strtoll(*p, &end, 10);
+    if (end == *p) return STATUS_INVALID;
+    if (errno == ERANGE) return STATUS_OVERFLOW;
+    *p = end;
+    *out = (int64_t) v;
+    return STATUS_OK;
+}
+
+/**
+ * @fn parse_line
+ * @brief Applies one line of a coordinate-list file to a graph.
+ * @param g Pointer to the graph.
+ * @param line Line to parse.
+ * @return Status indicating success or failure.
+ */
+static Status parse_line(SparseGraph *g, const char *line) {
+    const char *p = line;
+    while (isspace((unsigned char) *p)) p++;
+    if (*p == '\0' || *p == '#') return STATUS_OK;
+
+    Status st;
+    int64_t f[4];
+    bool extent = strncmp(p, "extent", 6) == 0 && (isspace((unsigned char) p[6]) || p[6] == ',');
+    if (extent) {
+        p += 6;
+        for (size_t i = 0; i < 4; ++i) {
+            if ((st = parse_int64(&p, &f[i])) != STATUS_OK) return st;
+        }
+    } else {
+        // A single printable character, then the row and the column
+        char freq = *p++;
+        if (!isprint((unsigned char) freq) || freq == '.' ||
+            !(isspace((unsigned char) *p) || *p == ','))
+            return STATUS_INVALID;
+        for (size_t i = 0; i < 2; ++i) {
+            if ((st = parse_int64(&p, &f[i])) != STATUS_OK) return st;
+        }
+        f[2] = (unsigned char) freq;
+    }
+    while (isspace((unsigned char) *p)) p++;
+    if (*p != '\0') return STATUS_INVALID;
+
+    if (extent) return sparse_graph_set_extent(g, f[0], f[1], f[2], f[3]);
+    return sparse_graph_insert(g, (char) f[2], f[0], f[1]);
+}
+
+/**
+ * @fn sparse_graph_load
+ * @brief Loads a sparse graph from a coordinate-list file.
+ * @param g Pointer to the graph.
+ * @param path Path to the coordinate-list file.
+ * @return Status indicating success or failure.
+ */
+Status sparse_graph_load(SparseGraph *g, const char *path) {
+    if (!g || !path) return STATUS_INVALID;
+
+    FILE *fp = fopen(path, "r");
+    if (!fp) return STATUS_IO;
+
+    Status st = sparse_graph_init(g);
+    if (st != STATUS_OK) {
+        fclose(fp);
+        return st;
+    }
+
+    char *line = NULL;
+    size_t len = 0;
+    while (st == STATUS_OK && custom_getlines(&line, &len, fp) != (size_t) -1) {
+        st = parse_line(g, line);
+    }
+
+    free(line);
+    fclose(fp);
+    if (st != STATUS_OK) sparse_graph_free(g);
+    return st;
+}
+
+/**
+ * @fn sparse_graph_occupied
+ * @brief Checks whether a cell holds an antenna.
+ * @param g Pointer to the graph.
+ * @param row Row of the cell.
+ * @param col Column of the cell.
+ * @return True if an antenna stands on the cell.
+ */
+bool sparse_graph_occupied(const SparseGraph *g, int64_t row, int64_t col) {
+    if (!g || !g->occupied.keys) return false;
+    return g->occupied.used[sparse_slot(&g->occupied, (SparseCoord) {.row = row, .col = col})];
+}
+
+/**
+ * @fn sparse_graph_freq_buckets
+ * @brief Groups the antenna indices of a sparse graph by frequency.
+ * @param g Pointer to the graph.
+ * @param out Pointer to the FreqBuckets to be filled.
+ * @return Status indicating success or failure.
+ */
+Status sparse_graph_freq_buckets(const SparseGraph *g, FreqBuckets *out) {
+    if (!g || !out) return STATUS_INVALID;
+    memset(out->start, 0, sizeof(out->start));
+    out->idx = NULL;
+
+    for (size_t i = 0; i < g->n; ++i) out->start[(unsigned char) g->v[i].freq + 1]++;
+    for (size_t f = 0; f < FREQ_SLOTS; ++f) out->start[f + 1] += out->start[f];
+    if (g->n == 0) return STATUS_OK;
+
+    out->idx = malloc(g->n * sizeof(size_t));
+    if (!out->idx) return STATUS_ALLOC;
+
+    size_t fill[FREQ_SLOTS];
+    memcpy(fill, out->start, sizeof(fill));
+    for (size_t i = 0; i < g->n; ++i) out->idx[fill[(unsigned char) g->v[i].freq]++] = i;
+    return STATUS_OK;
+}
+
+/**
+ * @fn by_cell
+ * @brief qsort comparator ordering sparse cells by row, then column.
+ * @param a Pointer to the first cell.
+ * @param b Pointer to the second cell.
+ * @return Comparison result.
+ */
+static int by_cell(const void *a, const void *b) {
+    const SparseCoord *x = a, *y = b;
+    if (x->row != y->row) return (x->row > y->row) - (x->row < y->row);
+    return (x->col > y->col) - (x->col < y->col);
+}
+
+/**
+ * @fn sort_unique
+ * @brief Sorts cells and drops the duplicates in place.
+ * @param c Cells.
+ * @param n Number of cells.
+ * @return The number of distinct cells.
+ */
+static size_t sort_unique(SparseCoord *c, size_t n) {
+    if (n < 2) return n;
+    qsort(c, n, sizeof(SparseCoord), by_cell);
+    size_t m = 1;
+    for (size_t i = 1; i < n; ++i) {
+        if (c[i].row != c[m - 1].row || c[i].col != c[m - 1].col) c[m++] = c[i];
+    }
+    return m;
+}
+
+/**
+ * @struct SparseDangerJob
+ *
+ * @brief Shared state of one sparse_danger_points() call.
+ */
+typedef struct {
+    const SparseGraph *g;
+    const FreqBuckets *buckets;
+    const char *freq;            /* frequency of each task              */
+    SparseCoordList *lists;      /* danger cells of each task           */
+} SparseDangerJob;
+
+/**
+ * @fn push_cell
+ * @brief Appends a cell to a growable array.
+ * @param l Pointer to the list.
+ * @param cap Pointer to its capacity.
+ * @param c Cell to append.
+ * @return Status indicating success or failure.
+ */
+static Status push_cell(SparseCoordList *l, size_t *cap, SparseCoord c) {
+    if (l->count == *cap) {
+        size_t next = *cap ? *cap * 2 : 64;
+        SparseCoord *p = realloc(l->coord, next * sizeof(SparseCoord));
+        if (!p) return STATUS_ALLOC;
+        l->coord = p;
+        *cap = next;
+    }
+    l->coord[l->count++] = c;
+    return STATUS_OK;
+}
+
+/**
+ * @fn sparse_danger_task
+ * @brief Collects the in-extent antinodes of one frequency, sorted and deduplicated.
+ * @param task Index of the frequency in the job.
+ * @param worker Index of the executing worker (unused).
+ * @param ctx Pointer to the SparseDangerJob.
+ * @return Status indicating success or failure.
+ */
+static Status sparse_danger_task(size_t task, size_t worker, void *ctx) {
+    (void) worker;
+    SparseDangerJob *job = ctx;
+    const SparseGraph *g = job->g;
+    const size_t *idx = freq_bucket(job->buckets, job->freq[task]);
+    size_t k = freq_bucket_size(job->buckets, job->freq[task]);
+    SparseCoordList *out = &job->lists[task];
+    size_t cap = 0;
+
+    Status st = STATUS_OK;
+    for (size_t i = 0; i < k && st == STATUS_OK; ++i) {
+        const SparseAntenna *a = &g->v[idx[i]];
+        for (size_t j = i + 1; j < k && st == STATUS_OK; ++j) {
+            const SparseAntenna *b = &g->v[idx[j]];
+            int64_t dr = b->row - a->row;
+            int64_t dc = b->col - a->col;
+            if (dr == 0 && dc == 0) continue; // skip same point
+
+            if (in_extent(g, a->row - dr, a->col - dc))
+                st = push_cell(out, &cap, (SparseCoord) {.row = a->row - dr, .col = a->col - dc});
+            if (st == STATUS_OK && in_extent(g, b->row + dr, b->col + dc))
+                st = push_cell(out, &cap, (SparseCoord) {.row = b->row + dr, .col = b->col + dc});
+        }
+    }
+    out->count = sort_unique(out->coord, out->count);
+    return st;
+}
+
+/**
+ * @fn sparse_danger_points
+ * @brief Computes the in-extent danger cells of some or all frequencies.
+ * @param g Pointer to the graph.
+ * @param freqs Frequencies to check, NULL for all of them.
+ * @param k Number of entries in freqs.
+ * @param n_workers Number of worker threads (0 for one per processor).
+ * @param out Pointer to the SparseCoordList to be filled.
+ * @return Status indicating success or failure.
+ */
+Status sparse_danger_points(const SparseGraph *g, const char *freqs, size_t k, size_t n_workers,
+                            SparseCoordList *out) {
+    if (!g || !out || (k && !freqs)) return STATUS_INVALID;
+    out->coord = NULL;
+    out->count = 0;
+
+    bool wanted[FREQ_SLOTS] = {false};
+    for (size_t i = 0; i < k; ++i) wanted[(unsigned char) freqs[i]] = true;
+
+    FreqBuckets buckets;
+    Status st = sparse_graph_freq_buckets(g, &buckets);
+    if (st != STATUS_OK) return st;
+
+    // Schedule the largest buckets first so the pool stays balanced
+    size_t order[FREQ_SLOTS][2];
+    size_t nf = 0;
+    for (size_t f = 0; f < FREQ_SLOTS; ++f) {
+        size_t size = buckets.start[f + 1] - buckets.start[f];
+        if (size >= 2 && (!freqs || wanted[f])) {
+            order[nf][0] = size;
+            order[nf][1] = f;
+            nf++;
+        }
+    }
+    qsort(order, nf, sizeof(order[0]), bucket_compare_size);
+    char freq[FREQ_SLOTS];
+    for (size_t t = 0; t < nf; ++t) freq[t] = (char) order[t][1];
+
+    SparseDangerJob job = {.g = g, .buckets = &buckets, .freq = freq};
+    job.lists = calloc(nf ? nf : 1, sizeof(SparseCoordList));
+    if (!job.lists) {
+        freq_buckets_free(&buckets);
+        return STATUS_ALLOC;
+    }
+    st = parallel_for(nf, n_workers, sparse_danger_task, &job);
+    freq_buckets_free(&buckets);
+
+    // Merge the frequencies: a single one is already sorted and unique
+    if (st == STATUS_OK && nf == 1) {
+        *out = job.lists[0];
+        job.lists[0].coord = NULL;
+    } else if (st == STATUS_OK && nf > 1) {
+        size_t total = 0;
+        for (size_t t = 0; t < nf; ++t) total += job.lists[t].count;
+        out->coord = malloc((total ? total : 1) * sizeof(SparseCoord));
+        if (!out->coord) {
+            st = STATUS_ALLOC;
+        } else {
+            for (size_t t = 0; t < nf; ++t) {
+                if (job.lists[t].count == 0) continue;
+                memcpy(out->coord + out->count, job.lists[t].coord, job.lists[t].count * sizeof(SparseCoord));
+                out->count += job.lists[t].count;
+            }
+            out->count = sort_unique(out->coord, out->count);
+        }
+    }
+    for (size_t t = 0; t < nf; ++t) free(job.lists[t].coord);
+    free(job.lists);
+    if (st != STATUS_OK) sparse_coord_list_free(out);
+    return st;
+}
+
+/**
+ * @fn sparse_coord_list_contains
+ * @brief Checks whether a sorted list holds a cell.
+ * @param l Pointer to the list.
+ * @param row Row of the cell.
+ * @param col Column of the cell.
+ * @return True if the cell is in the list.
+ */
+bool sparse_coord_list_contains(const SparseCoordList *l, int64_t row, int64_t col) {
+    if (!l) return false;
+    SparseCoord key = {.row = row, .col = col};
+    size_t lo = 0, hi = l->count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        int c = by_cell(&l->coord[mid], &key);
+        if (c == 0) return true;
+        if (c < 0) lo = mid + 1;
+        else hi = mid;
+    }
+    return false;
+}
+
+/**
+ * @fn sparse_coord_list_free
+ * @brief Frees the resources of a SparseCoordList.
+ * @param l Pointer to the list.
+ */
+void sparse_coord_list_free(SparseCoordList *l) {
+    if (!l) return;
+    free(l->coord);
+    l->coord = NULL;
+    l->count = 0;
+}
+
+/**
+ * @fn sparse_graph_free
+ * @brief Frees the resources of a SparseGraph.
+ * @param g Pointer to the graph.
+ */
+void sparse_graph_free(SparseGraph *g) {
+    if (!g) return;
+    free(g->v);
+    free(g->occupied.keys);
+    free(g->occupied.used);
+    memset(g, 0, sizeof(*g));
+}
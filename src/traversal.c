@@ -0,0 +1,274 @@
+/**
+ * @file traversal.c
+ * @brief Implementation of the bitmap-based graph traversals.
+ *
+ * Bitmaps hold one bit per vertex in 64-bit words, so membership tests and
+ * frontier sweeps touch n/8 bytes, and empty words are skipped whole.
+ * The multi-source BFS turns the layout around: one word per vertex, one
+ * bit per search.
+ *
+ * @author Ahmet Abdullah GULTEKIN
+ * @date 2025-05-25
+ *
+ * @see traversal.h for the header file containing the function prototypes.
+ */
+
+#include <stdlib.h>     /* malloc, calloc, free */
+#include <string.h>     /* memset */
+#include "../include/traversal.h"
+#include "../include/bitgrid.h"
+#include "../include/parallel.h"
+
+/**
+ * @fn bit_test
+ * @brief Tests bit i of a bitmap.
+ * @param bits Bitmap.
+ * @param i Bit index.
+ * @return True if the bit is set, false otherwise.
+ */
+static inline bool bit_test(const uint64_t *bits, size_t i) {
+    return (bits[i >> 6] >> (i & 63)) & 1;
+}
+
+/**
+ * @fn bit_set
+ * @brief Sets bit i of a bitmap.
+ * @param bits Bitmap.
+ * @param i Bit index.
+ */
+static inline void bit_set(uint64_t *bits, size_t i) {
+    bits[i >> 6] |= (uint64_t) 1 << (i & 63);
+}
+
+/**
+ * @fn top_down
+ * @brief Expands the frontier by scanning the neighbours of its vertices.
+ * @param g Pointer to the graph.
+ * @param words Words per bitmap.
+ * @param frontier Current frontier.
+ * @param next Output frontier (cleared by the caller).
+ * @param visited Visited set, updated.
+ */
+static void top_down(const Graph *g, size_t words, const uint64_t *frontier, uint64_t *next, uint64_t *visited) {
+    for (size_t w = 0; w < words; ++w) {
+        for (uint64_t bits = frontier[w]; bits; bits &= bits - 1) {
+            size_t v = w * 64 + bitgrid_lowest_bit(bits);
+            for (EdgeNode *e = g->adj[v]; e; e = e->next) {
+                if (bit_test(visited, e->dest)) continue;
+                bit_set(visited, e->dest);
+                bit_set(next, e->dest);
+            }
+        }
+    }
+}
+
+/**
+ * @fn bottom_up
+ * @brief Expands the frontier by letting every unvisited vertex look for a parent in it.
+ * @param g Pointer to the graph.
+ * @param words Words per bitmap.
+ * @param frontier Current frontier.
+ * @param next Output frontier (cleared by the caller).
+ * @param visited Visited set, updated.
+ */
+static void bottom_up(const Graph *g, size_t words, const uint64_t *frontier, uint64_t *next, uint64_t *visited) {
+    for (size_t w = 0; w < words; ++w) {
+        uint64_t open = ~visited[w];
+        if (w == words - 1 && g->n % 64) open &= ((uint64_t) 1 << (g->n % 64)) - 1;
+        for (; open; open &= open - 1) {
+            size_t v = w * 64 + bitgrid_lowest_bit(open);
+            for (EdgeNode *e = g->adj[v]; e; e = e->next) {
+                if (!bit_test(frontier, e->dest)) continue;
+                // One parent is enough; the rest of the list is skipped
+                next[w] |= (uint64_t) 1 << (v & 63);
+                break;
+            }
+        }
+        visited[w] |= next[w];
+    }
+}
+
+/**
+ * @fn graph_bfs_do
+ * @brief Direction-optimizing breadth-first search.
+ * @param g Pointer to the graph.
+ * @param start Starting vertex index.
+ * @param fn Optional function to call for each visited vertex.
+ * @param ctx Context pointer to pass to the function.
+ * @param level Optional output array of vertex levels.
+ * @return Status indicating success or failure.
+ */
+Status graph_bfs_do(const Graph *g, size_t start, VisitFn fn, void *ctx, uint32_t *level) {
+    if (!g || start >= g->n || (!fn && !level)) return STATUS_INVALID;
+
+    size_t words = (g->n + 63) / 64;
+    uint64_t *visited = calloc(words, sizeof(uint64_t));
+    uint64_t *frontier = calloc(words, sizeof(uint64_t));
+    uint64_t *next = calloc(words, sizeof(uint64_t));
+    size_t *deg = malloc(g->n * sizeof(size_t));
+    if (!visited || !frontier || !next || !deg) {
+        free(visited);
+        free(frontier);
+        free(next);
+        free(deg);
+        return STATUS_ALLOC;
+    }
+
+    size_t edges_left = 0;
+    for (size_t v = 0; v < g->n; ++v) {
+        deg[v] = 0;
+        for (EdgeNode *e = g->adj[v]; e; e = e->next) deg[v]++;
+        edges_left += deg[v];
+    }
+    if (level) {
+        for (size_t v = 0; v < g->n; ++v) level[v] = BFS_UNREACHED;
+    }
+
+    bit_set(visited, start);
+    bit_set(frontier, start);
+    bool bottom = false;
+    Status st = STATUS_OK;
+    for (uint32_t depth = 0;; ++depth) {
+        // Report the frontier and measure it for the direction heuristic
+        size_t frontier_vertices = 0, frontier_edges = 0;
+        for (size_t w = 0; w < words; ++w) {
+            for (uint64_t bits = frontier[w]; bits; bits &= bits - 1) {
+                size_t v = w * 64 + bitgrid_lowest_bit(bits);
+                frontier_vertices++;
+                frontier_edges += deg[v];
+                if (level) level[v] = depth;
+                if (fn && (st = fn(&g->v[v], ctx)) != STATUS_OK) goto done;
+            }
+        }
+        if (frontier_vertices == 0) break;
+        edges_left -= frontier_edges;
+
+        if (!bottom && frontier_edges > edges_left / BFS_ALPHA) bottom = true;
+        else if (bottom && frontier_vertices < g->n / BFS_BETA) bottom = false;
+
+        memset(next, 0, words * sizeof(uint64_t));
+        if (bottom) bottom_up(g, words, frontier, next, visited);
+        else top_down(g, words, frontier, next, visited);
+
+        uint64_t *t = frontier;
+        frontier = next;
+        next = t;
+    }
+
+    done:
+    free(visited);
+    free(frontier);
+    free(next);
+    free(deg);
+    return st;
+}
+
+/**
+ * @struct MsBfsJob
+ *
+ * @brief Shared state of one graph_msbfs() call.
+ */
+typedef struct {
+    const Graph *g;
+    const size_t *sources;
+    size_t n_sources;
+    size_t *reached;     /* optional per-source counts          */
+    uint32_t *dist;      /* optional per-source distance rows   */
+    uint64_t *lanes;     /* per-worker seen, visit and next words */
+} MsBfsJob;
+
+/**
+ * @fn msbfs_task
+ * @brief Runs the searches of one batch of sources.
+ * @param task Batch number.
+ * @param worker Worker index.
+ * @param ctx Pointer to the MsBfsJob.
+ * @return Always STATUS_OK.
+ */
+static Status msbfs_task(size_t task, size_t worker, void *ctx) {
+    MsBfsJob *job = ctx;
+    const Graph *g = job->g;
+    size_t n = g->n;
+    size_t base = task * MSBFS_LANES;
+    size_t lanes = job->n_sources - base < MSBFS_LANES ? job->n_sources - base : MSBFS_LANES;
+
+    uint64_t *seen = job->lanes + worker * 3 * n;
+    uint64_t *visit = seen + n;
+    uint64_t *next = visit + n;
+    memset(seen, 0, 2 * n * sizeof(uint64_t));
+
+    uint64_t all = lanes == 64 ? UINT64_MAX : ((uint64_t) 1 << lanes) - 1;
+    size_t count[MSBFS_LANES] = {0};
+    for (size_t b = 0; b < lanes; ++b) {
+        size_t s = job->sources[base + b];
+        seen[s] |= (uint64_t) 1 << b;
+        visit[s] |= (uint64_t) 1 << b;
+        count[b]++;
+        if (job->dist) {
+            uint32_t *row = job->dist + (base + b) * n;
+            for (size_t v = 0; v < n; ++v) row[v] = BFS_UNREACHED;
+            row[s] = 0;
+        }
+    }
+
+    for (uint32_t depth = 1;; ++depth) {
+        // Pull: a vertex joins every search that has one of its neighbours in the frontier
+        bool grown = false;
+        for (size_t v = 0; v < n; ++v) {
+            uint64_t in = 0;
+            if (seen[v] != all) {
+                for (EdgeNode *e = g->adj[v]; e; e = e->next) in |= visit[e->dest];
+            }
+            next[v] = in & ~seen[v];
+        }
+        for (size_t v = 0; v < n; ++v) {
+            uint64_t fresh = next[v];
+            visit[v] = fresh;
+            if (!fresh) continue;
+            grown = true;
+            seen[v] |= fresh;
+            for (; fresh; fresh &= fresh - 1) {
+                size_t b = bitgrid_lowest_bit(fresh);
+                count[b]++;
+                if (job->dist) job->dist[(base + b) * n + v] = depth;
+            }
+        }
+        if (!grown) break;
+    }
+
+    if (job->reached) {
+        for (size_t b = 0; b < lanes; ++b) job->reached[base + b] = count[b];
+    }
+    return STATUS_OK;
+}
+
+/**
+ * @fn graph_msbfs
+ * @brief Runs a breadth-first search from many sources at once.
+ * @param g Pointer to the graph.
+ * @param sources Start vertex of each search.
+ * @param n_sources Number of searches.
+ * @param n_workers Number of worker threads (0 for one per processor).
+ * @param reached Optional output array of reached counts.
+ * @param dist Optional output array of distance rows.
+ * @return Status indicating success or failure.
+ */
+Status graph_msbfs(const Graph *g, const size_t *sources, size_t n_sources, size_t n_workers,
+                   size_t *reached, uint32_t *dist) {
+    if (!g || (!sources && n_sources) || (!reached && !dist)) return STATUS_INVALID;
+    for (size_t i = 0; i < n_sources; ++i) {
+        if (sources[i] >= g->n) return STATUS_INVALID;
+    }
+    if (n_sources == 0) return STATUS_OK;
+
+    size_t n_tasks = (n_sources + MSBFS_LANES - 1) / MSBFS_LANES;
+    n_workers = parallel_worker_count(n_workers, n_tasks);
+
+    MsBfsJob job = {.g = g, .sources = sources, .n_sources = n_sources, .reached = reached, .dist = dist};
+    job.lanes = malloc(n_workers * 3 * g->n * sizeof(uint64_t));
+    if (!job.lanes) return STATUS_ALLOC;
+
+    Status st = parallel_for(n_tasks, n_workers, msbfs_task, &job);
+    free(job.lanes);
+    return st;
+}